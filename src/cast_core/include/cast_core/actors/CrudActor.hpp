@@ -77,6 +77,50 @@ namespace genny::actor {
  *       OperationName: drop
  * ```
  *
+ * A phase can generate its documents ahead of time on helper threads, so that generating them
+ * doesn't limit how fast the actor threads can send operations:
+ *
+ * ```yaml
+ *   - Repeat: 1000
+ *     Collection: test
+ *     PreGenerate:
+ *       Depth: 1024  # Documents kept ready for each document field of each operation.
+ *       Threads: 2   # Helper threads, shared by all actors of this Actor block.
+ *     Operation:
+ *       OperationName: insertOne
+ *       OperationCommand:
+ *         Document: {a: {^FastRandomString: {length: 1000}}}
+ * ```
+ *
+ * Pre-generated documents are seeded from each actor's random generator so runs are still
+ * reproducible, unless a template has a `latest` distribution reading an ^Inc that another
+ * operation's template advances. `insertMany` and `createIndex` always generate their documents
+ * inline. An operation's documents are only generated once the actor first runs it, and the
+ * helper threads are started from actor threads, so they follow `--cpu-affinity` and `CpuSet`.
+ *
+ * By default each iteration runs every operation in order. With `OperationSelection: weighted`
+ * each iteration instead runs one operation, picked at random in proportion to its `Weight`,
+ * for a mix like YCSB's on a single actor:
+ *
+ * ```yaml
+ *   - Duration: 5 minutes
+ *     Collection: test
+ *     OperationSelection: weighted
+ *     Operations:
+ *     - OperationName: findOne
+ *       Weight: 95
+ *       OperationCommand:
+ *         Filter: {_id: {^RandomInt: {min: 0, max: 100000}}}
+ *     - OperationName: updateOne
+ *       Weight: 5
+ *       OperationCommand:
+ *         Filter: {_id: {^RandomInt: {min: 0, max: 100000}}}
+ *         Update: {$inc: {n: 1}}
+ * ```
+ *
+ * Each operation records its own metrics, named after its `OperationName` unless it has an
+ * `OperationMetricsName`.
+ *
  * Owner: STM
  */
 class CrudActor : public Actor {
@@ -29,6 +29,9 @@ namespace genny::actor {
  * random collection to update. The actor records the latency of each update, and the total number
  * of documents updated.
  *
+ * Collections are picked by a CollectionSelector, so `CollectionName`, `CollectionSelection` and
+ * `CollectionSkew` can change which ones and how.
+ *
  * Owner: product-perf
  */
 class MultiCollectionQuery : public Actor {
@@ -30,6 +30,8 @@ namespace genny::actor {
 /**
  * This actor will sample 10 documents from the collections it is tasked with
  * continuously.
+ * Which of them each sample comes from follows `CollectionSelection`, uniform
+ * by default.
  *
  * Example yaml can be found at src/workloads/docs/RandomSampler.yml
  *
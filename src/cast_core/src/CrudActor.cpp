@@ -15,13 +15,19 @@
 #include <cast_core/actors/CrudActor.hpp>
 
 #include <chrono>
+#include <cmath>
+#include <map>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include <mongocxx/client.hpp>
 #include <mongocxx/collection.hpp>
 
 #include <boost/log/trivial.hpp>
+#include <boost/random/discrete_distribution.hpp>
 #include <boost/throw_exception.hpp>
 
 #include <bsoncxx/json.hpp>
@@ -31,6 +37,8 @@
 #include <gennylib/context.hpp>
 #include <gennylib/conventions.hpp>
 
+#include <value_generators/PreGenerator.hpp>
+
 using BsonView = bsoncxx::document::view;
 using CrudActor = genny::actor::CrudActor;
 
@@ -276,6 +284,95 @@ ThrowMode decodeThrowMode(const Node& operation, PhaseContext& phaseContext) {
 
 bsoncxx::document::value emptyDoc = bsoncxx::from_json("{}");
 
+// The PreGenerator of each phase that has one, see phasePreGenerator().
+using PreGenerators = std::map<const PhaseContext*, std::weak_ptr<PreGenerator>>;
+
+/**
+ * @return the PreGenerator for a phase with `PreGenerate: {Depth: <int>, Threads: <int>}`, or
+ * nullptr if it has none. Every actor of the same Actor block shares it, so `Threads` helper
+ * threads fill `Depth` documents for each document field of each operation of each actor.
+ */
+std::shared_ptr<PreGenerator> phasePreGenerator(PhaseContext& context) {
+    auto& config = context["PreGenerate"];
+    if (!config) {
+        return nullptr;
+    }
+    // Actors are constructed on one thread so this needs no lock.
+    auto& preGenerators = WorkloadContext::getActorSharedState<CrudActor, PreGenerators>();
+    auto& entry = preGenerators[&context];
+    auto preGenerator = entry.lock();
+    if (!preGenerator) {
+        const auto depth = config["Depth"].maybe<int64_t>().value_or(1024);
+        const auto threads = config["Threads"].maybe<int64_t>().value_or(1);
+        if (depth <= 0 || threads <= 0) {
+            BOOST_THROW_EXCEPTION(InvalidConfigurationException(
+                "PreGenerate Depth and Threads must be positive"));
+        }
+        preGenerator = std::make_shared<PreGenerator>(threads, depth);
+        entry = preGenerator;
+    }
+    return preGenerator;
+}
+
+/**
+ * The documents for one field of an operation, such as its `Filter`. They are generated on the
+ * actor's thread when they're needed, or ahead of time on helper threads if the phase has
+ * `PreGenerate`.
+ *
+ * Pre-generated documents come from a child of the actor's random generator, so they are as
+ * reproducible as inline ones but not the same documents. With `RandomSeeding: counter` they
+ * are the same documents.
+ */
+class DocumentSource {
+public:
+    DocumentSource(const Node& node, PhaseContext& context, ActorId id)
+        : _preGenerator{phasePreGenerator(context)} {
+        if (!_preGenerator) {
+            _generator.emplace(node.to<DocumentGenerator>(context, id));
+            return;
+        }
+        if (!node) {
+            BOOST_THROW_EXCEPTION(InvalidKeyException(
+                "Tried to access node that doesn't exist.", node.key(), &node));
+        }
+        auto& workload = context.workload();
+        const auto thread = ActorThread::of(context.actor(), id);
+        if (auto seed = workload.counterSeed()) {
+            _stream = _preGenerator->stream(
+                node,
+                id,
+                DocumentGenerator::CounterSeed{
+                    *seed, uint64_t(context.getPhaseNumber()), workload.randomEngine()},
+                thread);
+        } else {
+            _stream = _preGenerator->stream(node, context.rng(id).child(), id, thread);
+        }
+    }
+
+    /**
+     * @return the next document. It is only valid until the next call.
+     */
+    bsoncxx::document::view next() {
+        return _stream ? _stream->next() : _generator->evaluateInto(_buffer);
+    }
+
+    /**
+     * @return a copy of the next document, e.g. for a bulk write's models.
+     */
+    bsoncxx::document::value value() {
+        return _stream ? bsoncxx::document::value{_stream->next()} : (*_generator)();
+    }
+
+private:
+    // Keeps the helper threads running for as long as _stream is used.
+    std::shared_ptr<PreGenerator> _preGenerator;
+    std::shared_ptr<PreGenerator::Stream> _stream;
+
+    // Otherwise documents are generated inline.
+    std::optional<DocumentGenerator> _generator;
+    DocumentGenerator::Buffer _buffer;
+};
+
 
 // A large number of subclasses have
 // - metrics::Operation
@@ -287,7 +384,7 @@ bsoncxx::document::value emptyDoc = bsoncxx::from_json("{}");
 struct BaseOperation {
     ThrowMode throwMode;
 
-    using MaybeDoc = std::optional<bsoncxx::document::value>;
+    using MaybeDoc = std::optional<bsoncxx::document::view_or_value>;
 
     explicit BaseOperation(PhaseContext& phaseContext, const Node& operation)
         : throwMode{decodeThrowMode(operation, phaseContext)} {}
@@ -384,30 +481,30 @@ struct InsertOneOperation : public WriteOperation {
           _operation{operation},
           _options{opNode["OperationOptions"].maybe<mongocxx::options::insert>().value_or(
               mongocxx::options::insert{})},
-          _document{opNode["Document"].to<DocumentGenerator>(context, id)} {}
+          _document{opNode["Document"], context, id} {}
 
     mongocxx::model::write getModel() override {
-        auto document = _document();
+        auto document = _document.value();
         return mongocxx::model::insert_one{std::move(document)};
     }
 
     void run(mongocxx::client_session& session) override {
-        auto document = _document();
-        auto size = document.view().length();
+        auto document = _document.next();
+        auto size = document.length();
 
         this->doBlock(_operation, [&](metrics::OperationContext& ctx) {
-            (_onSession) ? _collection.insert_one(session, document.view(), _options)
-                         : _collection.insert_one(document.view(), _options);
+            (_onSession) ? _collection.insert_one(session, document, _options)
+                         : _collection.insert_one(document, _options);
             ctx.addDocuments(1);
             ctx.addBytes(size);
-            return std::make_optional(std::move(document));
+            return std::make_optional(document);
         });
     }
 
 private:
     bool _onSession;
     mongocxx::collection _collection;
-    DocumentGenerator _document;
+    DocumentSource _document;
     metrics::Operation _operation;
     mongocxx::options::insert _options;
 };
@@ -424,35 +521,34 @@ struct UpdateOneOperation : public WriteOperation {
           _onSession{onSession},
           _collection{std::move(collection)},
           _operation{operation},
-          _filter{opNode["Filter"].to<DocumentGenerator>(context, id)},
-          _update{opNode["Update"].to<DocumentGenerator>(context, id)} {}
+          _filter{opNode["Filter"], context, id},
+          _update{opNode["Update"], context, id} {}
 
     mongocxx::model::write getModel() override {
-        auto filter = _filter();
-        auto update = _update();
+        auto filter = _filter.value();
+        auto update = _update.value();
         return mongocxx::model::update_one{std::move(filter), std::move(update)};
     }
 
     void run(mongocxx::client_session& session) override {
-        auto filter = _filter();
-        auto update = _update();
+        auto filter = _filter.next();
+        auto update = _update.next();
         this->doBlock(_operation, [&](metrics::OperationContext& ctx) {
-            auto result = (_onSession)
-                ? _collection.update_one(session, filter.view(), update.view(), _options)
-                : _collection.update_one(filter.view(), update.view(), _options);
+            auto result = (_onSession) ? _collection.update_one(session, filter, update, _options)
+                                       : _collection.update_one(filter, update, _options);
             if (result) {
                 ctx.addDocuments(result->modified_count());
             }
             // pick an 'info' document...either one makes sense
-            return std::make_optional(std::move(update));
+            return std::make_optional(update);
         });
     }
 
 private:
     bool _onSession;
     mongocxx::collection _collection;
-    DocumentGenerator _filter;
-    DocumentGenerator _update;
+    DocumentSource _filter;
+    DocumentSource _update;
     metrics::Operation _operation;
     mongocxx::options::update _options;
 };
@@ -468,35 +564,34 @@ struct UpdateManyOperation : public WriteOperation {
           _onSession{onSession},
           _collection{std::move(collection)},
           _operation{operation},
-          _filter{opNode["Filter"].to<DocumentGenerator>(context, id)},
-          _update{opNode["Update"].to<DocumentGenerator>(context, id)} {}
+          _filter{opNode["Filter"], context, id},
+          _update{opNode["Update"], context, id} {}
 
     mongocxx::model::write getModel() override {
-        auto filter = _filter();
-        auto update = _update();
+        auto filter = _filter.value();
+        auto update = _update.value();
         return mongocxx::model::update_many{std::move(filter), std::move(update)};
     }
 
     void run(mongocxx::client_session& session) override {
-        auto filter = _filter();
-        auto update = _update();
+        auto filter = _filter.next();
+        auto update = _update.next();
 
         this->doBlock(_operation, [&](metrics::OperationContext& ctx) {
-            auto result = (_onSession)
-                ? _collection.update_many(session, filter.view(), update.view(), _options)
-                : _collection.update_many(filter.view(), update.view(), _options);
+            auto result = (_onSession) ? _collection.update_many(session, filter, update, _options)
+                                       : _collection.update_many(filter, update, _options);
             if (result) {
                 ctx.addDocuments(result->modified_count());
             }
-            return std::make_optional(std::move(update));
+            return std::make_optional(update);
         });
     }
 
 private:
     bool _onSession;
     mongocxx::collection _collection;
-    DocumentGenerator _filter;
-    DocumentGenerator _update;
+    DocumentSource _filter;
+    DocumentSource _update;
     metrics::Operation _operation;
     mongocxx::options::update _options;
 };
@@ -512,29 +607,29 @@ struct DeleteOneOperation : public WriteOperation {
           _onSession{onSession},
           _collection{std::move(collection)},
           _operation{operation},
-          _filter(opNode["Filter"].to<DocumentGenerator>(context, id)) {}
+          _filter(opNode["Filter"], context, id) {}
 
     mongocxx::model::write getModel() override {
-        auto filter = _filter();
+        auto filter = _filter.value();
         return mongocxx::model::delete_one{std::move(filter)};
     }
 
     void run(mongocxx::client_session& session) override {
-        auto filter = _filter();
+        auto filter = _filter.next();
         this->doBlock(_operation, [&](metrics::OperationContext& ctx) {
-            auto result = (_onSession) ? _collection.delete_one(session, filter.view(), _options)
-                                       : _collection.delete_one(filter.view(), _options);
+            auto result = (_onSession) ? _collection.delete_one(session, filter, _options)
+                                       : _collection.delete_one(filter, _options);
             if (result) {
                 ctx.addDocuments(result->deleted_count());
             }
-            return std::make_optional(std::move(filter));
+            return std::make_optional(filter);
         });
     }
 
 private:
     bool _onSession;
     mongocxx::collection _collection;
-    DocumentGenerator _filter;
+    DocumentSource _filter;
     metrics::Operation _operation;
     mongocxx::options::delete_options _options;
 };
@@ -550,29 +645,29 @@ struct DeleteManyOperation : public WriteOperation {
           _onSession{onSession},
           _collection{std::move(collection)},
           _operation{operation},
-          _filter{opNode["Filter"].to<DocumentGenerator>(context, id)} {}
+          _filter{opNode["Filter"], context, id} {}
 
     mongocxx::model::write getModel() override {
-        auto filter = _filter();
+        auto filter = _filter.value();
         return mongocxx::model::delete_many{std::move(filter)};
     }
 
     void run(mongocxx::client_session& session) override {
-        auto filter = _filter();
+        auto filter = _filter.next();
         this->doBlock(_operation, [&](metrics::OperationContext& ctx) {
-            auto results = (_onSession) ? _collection.delete_many(session, filter.view(), _options)
-                                        : _collection.delete_many(filter.view(), _options);
+            auto results = (_onSession) ? _collection.delete_many(session, filter, _options)
+                                        : _collection.delete_many(filter, _options);
             if (results) {
                 ctx.addDocuments(results->deleted_count());
             }
-            return std::make_optional(std::move(filter));
+            return std::make_optional(filter);
         });
     }
 
 private:
     bool _onSession;
     mongocxx::collection _collection;
-    DocumentGenerator _filter;
+    DocumentSource _filter;
     metrics::Operation _operation;
     mongocxx::options::delete_options _options;
 };
@@ -588,39 +683,39 @@ struct ReplaceOneOperation : public WriteOperation {
           _onSession{onSession},
           _collection{std::move(collection)},
           _operation{operation},
-          _filter{opNode["Filter"].to<DocumentGenerator>(context, id)},
-          _replacement{opNode["Replacement"].to<DocumentGenerator>(context, id)} {}
+          _filter{opNode["Filter"], context, id},
+          _replacement{opNode["Replacement"], context, id} {}
 
     mongocxx::model::write getModel() override {
-        auto filter = _filter();
-        auto replacement = _replacement();
+        auto filter = _filter.value();
+        auto replacement = _replacement.value();
         return mongocxx::model::replace_one{std::move(filter), std::move(replacement)};
     }
 
     void run(mongocxx::client_session& session) override {
-        auto filter = _filter();
-        auto replacement = _replacement();
-        auto size = replacement.view().length();
+        auto filter = _filter.next();
+        auto replacement = _replacement.next();
+        auto size = replacement.length();
 
         this->doBlock(_operation, [&](metrics::OperationContext& ctx) {
             auto result = (_onSession)
-                ? _collection.replace_one(session, filter.view(), replacement.view(), _options)
-                : _collection.replace_one(filter.view(), replacement.view(), _options);
+                ? _collection.replace_one(session, filter, replacement, _options)
+                : _collection.replace_one(filter, replacement, _options);
 
             if (result) {
                 ctx.addDocuments(result->modified_count());
             }
             ctx.addBytes(size);
 
-            return std::make_optional(std::move(replacement));
+            return std::make_optional(replacement);
         });
     }
 
 private:
     bool _onSession;
     mongocxx::collection _collection;
-    DocumentGenerator _filter;
-    DocumentGenerator _replacement;
+    DocumentSource _filter;
+    DocumentSource _replacement;
     metrics::Operation _operation;
     mongocxx::options::replace _options;
 };
@@ -752,21 +847,20 @@ struct CountDocumentsOperation : public BaseOperation {
           _onSession{onSession},
           _collection{std::move(collection)},
           _operation{operation},
-          _filter{opNode["Filter"].to<DocumentGenerator>(context, id)} {
+          _filter{opNode["Filter"], context, id} {
         if (opNode["Options"]) {
             _options = opNode["Options"].to<mongocxx::options::count>();
         }
     }
 
     void run(mongocxx::client_session& session) override {
-        auto filter = _filter();
+        auto filter = _filter.next();
 
         this->doBlock(_operation, [&](metrics::OperationContext& ctx) {
-            auto count = (_onSession)
-                ? _collection.count_documents(session, filter.view(), _options)
-                : _collection.count_documents(filter.view(), _options);
+            auto count = (_onSession) ? _collection.count_documents(session, filter, _options)
+                                      : _collection.count_documents(filter, _options);
             ctx.addDocuments(count);
-            return std::make_optional(std::move(filter));
+            return std::make_optional(filter);
         });
     }
 
@@ -775,7 +869,7 @@ private:
     bool _onSession;
     mongocxx::collection _collection;
     mongocxx::options::count _options;
-    DocumentGenerator _filter;
+    DocumentSource _filter;
     metrics::Operation _operation;
 };
 
@@ -832,22 +926,22 @@ struct FindOperation : public BaseOperation {
           _onSession{onSession},
           _collection{std::move(collection)},
           _operation{operation},
-          _filter{opNode["Filter"].to<DocumentGenerator>(context, id)} {
+          _filter{opNode["Filter"], context, id} {
         if (opNode["Options"]) {
             _options = opNode["Options"].to<mongocxx::options::find>();
         }
     }
 
     void run(mongocxx::client_session& session) override {
-        auto filter = _filter();
+        auto filter = _filter.next();
         this->doBlock(_operation, [&](metrics::OperationContext& ctx) {
-            auto cursor = (_onSession) ? _collection.find(session, filter.view(), _options)
-                                       : _collection.find(filter.view(), _options);
+            auto cursor = (_onSession) ? _collection.find(session, filter, _options)
+                                       : _collection.find(filter, _options);
             for (auto&& doc : cursor) {
                 ctx.addDocuments(1);
                 ctx.addBytes(doc.length());
             }
-            return std::make_optional(std::move(filter));
+            return std::make_optional(filter);
         });
     }
 
@@ -856,7 +950,7 @@ private:
     bool _onSession;
     mongocxx::collection _collection;
     mongocxx::options::find _options;
-    DocumentGenerator _filter;
+    DocumentSource _filter;
     metrics::Operation _operation;
 };
 
@@ -871,22 +965,22 @@ struct FindOneOperation : public BaseOperation {
           _onSession{onSession},
           _collection{std::move(collection)},
           _operation{operation},
-          _filter{opNode["Filter"].to<DocumentGenerator>(context, id)} {
+          _filter{opNode["Filter"], context, id} {
         if (opNode["Options"]) {
             _options = opNode["Options"].to<mongocxx::options::find>();
         }
     }
 
     void run(mongocxx::client_session& session) override {
-        auto filter = _filter();
+        auto filter = _filter.next();
         this->doBlock(_operation, [&](metrics::OperationContext& ctx) {
-            auto result = (_onSession) ? _collection.find_one(session, filter.view(), _options)
-                                       : _collection.find_one(filter.view(), _options);
+            auto result = (_onSession) ? _collection.find_one(session, filter, _options)
+                                       : _collection.find_one(filter, _options);
             if (result) {
                 ctx.addDocuments(1);
                 ctx.addBytes(result->view().length());
             }
-            return std::make_optional(std::move(filter));
+            return std::make_optional(filter);
         });
     }
 
@@ -894,7 +988,7 @@ private:
     bool _onSession;
     mongocxx::collection _collection;
     mongocxx::options::find _options;
-    DocumentGenerator _filter;
+    DocumentSource _filter;
     metrics::Operation _operation;
 };
 
@@ -909,21 +1003,21 @@ struct FindOneAndUpdateOperation : public BaseOperation {
           _onSession{onSession},
           _collection{std::move(collection)},
           _operation{operation},
-          _filter{opNode["Filter"].to<DocumentGenerator>(context, id)},
-          _update{opNode["Update"].to<DocumentGenerator>(context, id)} {}
+          _filter{opNode["Filter"], context, id},
+          _update{opNode["Update"], context, id} {}
 
     void run(mongocxx::client_session& session) override {
-        auto filter = _filter();
-        auto update = _update();
+        auto filter = _filter.next();
+        auto update = _update.next();
         this->doBlock(_operation, [&](metrics::OperationContext& ctx) {
             auto result = (_onSession)
-                ? _collection.find_one_and_update(session, filter.view(), update.view(), _options)
-                : _collection.find_one_and_update(filter.view(), update.view(), _options);
+                ? _collection.find_one_and_update(session, filter, update, _options)
+                : _collection.find_one_and_update(filter, update, _options);
             if (result) {
                 ctx.addDocuments(1);
                 ctx.addBytes(result->view().length());
             }
-            return std::make_optional(std::move(filter));
+            return std::make_optional(filter);
         });
     }
 
@@ -931,8 +1025,8 @@ private:
     bool _onSession;
     mongocxx::collection _collection;
     mongocxx::options::find_one_and_update _options;
-    DocumentGenerator _filter;
-    DocumentGenerator _update;
+    DocumentSource _filter;
+    DocumentSource _update;
     metrics::Operation _operation;
 };
 
@@ -947,19 +1041,18 @@ struct FindOneAndDeleteOperation : public BaseOperation {
           _onSession{onSession},
           _collection{std::move(collection)},
           _operation{operation},
-          _filter{opNode["Filter"].to<DocumentGenerator>(context, id)} {}
+          _filter{opNode["Filter"], context, id} {}
 
     void run(mongocxx::client_session& session) override {
-        auto filter = _filter();
+        auto filter = _filter.next();
         this->doBlock(_operation, [&](metrics::OperationContext& ctx) {
-            auto result = (_onSession)
-                ? _collection.find_one_and_delete(session, filter.view(), _options)
-                : _collection.find_one_and_delete(filter.view(), _options);
+            auto result = (_onSession) ? _collection.find_one_and_delete(session, filter, _options)
+                                       : _collection.find_one_and_delete(filter, _options);
             if (result) {
                 ctx.addDocuments(1);
                 ctx.addBytes(result->view().length());
             }
-            return std::make_optional(std::move(filter));
+            return std::make_optional(filter);
         });
     }
 
@@ -967,7 +1060,7 @@ private:
     bool _onSession;
     mongocxx::collection _collection;
     mongocxx::options::find_one_and_delete _options;
-    DocumentGenerator _filter;
+    DocumentSource _filter;
     metrics::Operation _operation;
 };
 
@@ -982,22 +1075,21 @@ struct FindOneAndReplaceOperation : public BaseOperation {
           _onSession{onSession},
           _collection{std::move(collection)},
           _operation{operation},
-          _filter{opNode["Filter"].to<DocumentGenerator>(context, id)},
-          _replacement{opNode["Replacement"].to<DocumentGenerator>(context, id)} {}
+          _filter{opNode["Filter"], context, id},
+          _replacement{opNode["Replacement"], context, id} {}
 
     void run(mongocxx::client_session& session) override {
-        auto filter = _filter();
-        auto replacement = _replacement();
+        auto filter = _filter.next();
+        auto replacement = _replacement.next();
         this->doBlock(_operation, [&](metrics::OperationContext& ctx) {
             auto result = (_onSession)
-                ? _collection.find_one_and_replace(
-                      session, filter.view(), replacement.view(), _options)
-                : _collection.find_one_and_replace(filter.view(), replacement.view(), _options);
+                ? _collection.find_one_and_replace(session, filter, replacement, _options)
+                : _collection.find_one_and_replace(filter, replacement, _options);
             if (result) {
                 ctx.addDocuments(1);
                 ctx.addBytes(result->view().length());
             }
-            return std::make_optional(std::move(filter));
+            return std::make_optional(filter);
         });
     }
 
@@ -1005,8 +1097,8 @@ private:
     bool _onSession;
     mongocxx::collection _collection;
     mongocxx::options::find_one_and_replace _options;
-    DocumentGenerator _filter;
-    DocumentGenerator _replacement;
+    DocumentSource _filter;
+    DocumentSource _replacement;
     metrics::Operation _operation;
 };
 
@@ -1042,12 +1134,14 @@ struct InsertManyOperation : public BaseOperation {
     }
 
     void run(mongocxx::client_session& session) override {
-        std::vector<bsoncxx::document::view_or_value> writeOps;
-        size_t bytes = 0;
+        _documents.clear();
         for (auto&& docExpr : _docExprs) {
-            auto doc = docExpr();
-            bytes += doc.view().length();
-            writeOps.emplace_back(std::move(doc));
+            docExpr.appendTo(_documents);
+        }
+        auto& writeOps = _documents.views();
+        size_t bytes = 0;
+        for (auto&& doc : writeOps) {
+            bytes += doc.length();
         }
 
         this->doBlock(_operation, [&](metrics::OperationContext& ctx) {
@@ -1068,6 +1162,8 @@ private:
     mongocxx::options::insert _options;
     metrics::Operation _operation;
     std::vector<DocumentGenerator> _docExprs;
+    // Holds one batch of documents, reused by each run().
+    DocumentGenerator::Arena _documents;
 };
 
 /**
@@ -1261,15 +1357,44 @@ struct CrudActor::PhaseConfig {
     std::vector<std::unique_ptr<BaseOperation>> operations;
     metrics::Operation metrics;
 
+    // With `OperationSelection: weighted`, each iteration runs one of the operations, picked
+    // by their `Weight`s. Otherwise every iteration runs all of them in order.
+    std::optional<boost::random::discrete_distribution<size_t>> weights;
+    DefaultRandom& rng;
+
     PhaseConfig(PhaseContext& phaseContext, mongocxx::pool::entry& client, ActorId id)
         : collection{(
               *client)[getDbName(phaseContext)][phaseContext["Collection"].to<std::string>()]},
-          metrics{phaseContext.actor().operation("Crud", id)} {
+          metrics{phaseContext.actor().operation("Crud", id)},
+          rng{phaseContext.rng(id)} {
+        const auto selection =
+            phaseContext["OperationSelection"].maybe<std::string>().value_or("all");
+        if (selection != "all" && selection != "weighted") {
+            BOOST_THROW_EXCEPTION(InvalidConfigurationException(
+                "Unknown OperationSelection '" + selection + "'. Need one of all/weighted"));
+        }
+        const bool weighted = selection == "weighted";
+        std::vector<double> operationWeights;
+
         auto addOperation = [&](const Node& node) -> std::unique_ptr<BaseOperation> {
             auto& yamlCommand = node["OperationCommand"];
             auto opName = node["OperationName"].to<std::string>();
             auto onSession = yamlCommand["OnSession"].maybe<bool>().value_or(false);
 
+            if (weighted != bool(node["Weight"])) {
+                BOOST_THROW_EXCEPTION(InvalidConfigurationException(
+                    weighted ? "Operation '" + opName + "' needs a Weight"
+                             : "Weight needs OperationSelection: weighted"));
+            }
+            if (weighted) {
+                const auto weight = node["Weight"].to<double>();
+                if (!(std::isfinite(weight) && weight >= 0)) {
+                    BOOST_THROW_EXCEPTION(InvalidConfigurationException(
+                        "Weight must be a finite number that isn't negative"));
+                }
+                operationWeights.push_back(weight);
+            }
+
             // Grab the appropriate Operation struct defined by 'OperationName'.
             auto op = opConstructors.find(opName);
             if (op == opConstructors.end()) {
@@ -1285,19 +1410,39 @@ struct CrudActor::PhaseConfig {
             // Node is convertible to bool but only explicitly so need to do the odd-looking
             // `? true : false` thing.
             const bool perPhaseMetrics = phaseContext["MetricsName"] ? true : false;
+            // Operations of the same type are recorded together unless named apart, e.g. the
+            // point and range queries of a weighted mix.
+            const auto metricsName =
+                node["OperationMetricsName"].maybe<std::string>().value_or(opName);
 
             auto createOperation = op->second;
             return createOperation(yamlCommand,
                                    onSession,
                                    collection,
-                                   perPhaseMetrics ? phaseContext.operation(opName, id)
-                                                   : phaseContext.actor().operation(opName, id),
+                                   perPhaseMetrics
+                                       ? phaseContext.operation(metricsName, id)
+                                       : phaseContext.actor().operation(metricsName, id),
                                    phaseContext,
                                    id);
         };
 
         operations = phaseContext.getPlural<std::unique_ptr<BaseOperation>>(
             "Operation", "Operations", addOperation);
+
+        if (weighted) {
+            const auto total =
+                std::accumulate(operationWeights.begin(), operationWeights.end(), 0.0);
+            if (total <= 0) {
+                BOOST_THROW_EXCEPTION(
+                    InvalidConfigurationException("At least one Weight must be positive"));
+            }
+            if (!std::isfinite(total)) {
+                BOOST_THROW_EXCEPTION(
+                    InvalidConfigurationException("The Weights must add up to a finite number"));
+            }
+            // An alias table built once, so picking an operation is O(1).
+            weights.emplace(operationWeights);
+        }
     }
 };
 
@@ -1307,8 +1452,12 @@ void CrudActor::run() {
         for (const auto&& _ : config) {
             auto metricsContext = config->metrics.start();
 
-            for (auto&& op : config->operations) {
-                op->run(session);
+            if (config->weights) {
+                config->operations[(*config->weights)(config->rng)]->run(session);
+            } else {
+                for (auto&& op : config->operations) {
+                    op->run(session);
+                }
             }
 
             metricsContext.success();
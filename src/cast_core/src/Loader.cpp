@@ -63,6 +63,8 @@ struct Loader::PhaseConfig {
     int64_t numDocuments;
     int64_t batchSize;
     DocumentGenerator documentExpr;
+    // Reused for every batch.
+    DocumentGenerator::Arena batch;
     std::vector<index_type> indexes;
     int64_t collectionOffset;
 };
@@ -83,15 +85,11 @@ void genny::actor::Loader::run() {
                         // insert the next batch
                         int64_t numberToInsert =
                             std::min<int64_t>(config->batchSize, remainingInserts);
-                        auto docs = std::vector<bsoncxx::document::view_or_value>{};
-                        docs.reserve(remainingInserts);
-                        for (uint j = 0; j < numberToInsert; j++) {
-                            auto newDoc = config->documentExpr();
-                            docs.push_back(std::move(newDoc));
-                        }
+                        auto& docs =
+                            config->documentExpr.generateBatch(numberToInsert, config->batch);
                         {
                             auto individualOpCtx = _individualBulkLoad.start();
-                            auto result = collection.insert_many(std::move(docs));
+                            auto result = collection.insert_many(docs);
                             remainingInserts -= result->inserted_count();
                             individualOpCtx.success();
                         }
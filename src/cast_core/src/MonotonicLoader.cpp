@@ -33,8 +33,6 @@
 
 #include <value_generators/DocumentGenerator.hpp>
 
-#include <bsoncxx/builder/stream/document.hpp>
-
 
 namespace genny::actor {
 
@@ -68,6 +66,8 @@ struct MonotonicLoader::PhaseConfig {
     int64_t numDocuments;
     int64_t batchSize;
     DocumentGenerator documentExpr;
+    // Reused for every batch.
+    DocumentGenerator::Arena batch;
     std::vector<index_type> indexes;
     int64_t collectionOffset;
 };
@@ -89,20 +89,12 @@ void genny::actor::MonotonicLoader::run() {
                         // insert the next batch
                         int64_t numberToInsert =
                             std::min<int64_t>(config->batchSize, remainingInserts);
-                        auto docs = std::vector<bsoncxx::document::view_or_value>{};
-                        docs.reserve(remainingInserts);
-                        for (uint j = 0; j < numberToInsert; j++) {
-                            auto tmpDoc = config->documentExpr();
-                            auto builder = bsoncxx::builder::stream::document();
-                            builder << "_id" << ++id_num;
-                            builder << bsoncxx::builder::concatenate(tmpDoc.view());
-                            bsoncxx::document::value newDoc = builder
-                                << bsoncxx::builder::stream::finalize;
-                            docs.push_back(std::move(newDoc));
-                        }
+                        auto& docs = config->documentExpr.generateBatch(
+                            numberToInsert, config->batch, id_num + 1);
+                        id_num += numberToInsert;
                         {
                             auto individualOpCtx = _individualBulkLoad.start();
-                            auto result = collection.insert_many(std::move(docs));
+                            auto result = collection.insert_many(docs);
                             remainingInserts -= result->inserted_count();
                             individualOpCtx.success();
                         }
@@ -29,6 +29,7 @@
 #include <boost/log/trivial.hpp>
 
 #include <gennylib/Cast.hpp>
+#include <gennylib/CollectionSelector.hpp>
 #include <gennylib/context.hpp>
 #include <gennylib/conventions.hpp>
 
@@ -39,11 +40,14 @@ namespace genny::actor {
 /** @private */
 struct MultiCollectionQuery::PhaseConfig {
     PhaseConfig(PhaseContext& context, mongocxx::pool::entry& client, ActorId id)
-        : database{(*client)[context["Database"].to<std::string>()]},
-          numCollections{context["CollectionCount"].to<IntegerSpec>()},
+        : collections{context, (*client)[context["Database"].to<std::string>()], id},
           readConcern{context["ReadConcern"].maybe<mongocxx::read_concern>()},
-          filterExpr{std::move(context["Filter"].to<DocumentGenerator>(context, id))},
-          uniformDistribution{0, numCollections} {
+          filterExpr{std::move(context["Filter"].to<DocumentGenerator>(context, id))} {
+        if (readConcern) {
+            for (size_t i = 0; i < collections.size(); ++i) {
+                collections[i].read_concern(*readConcern);
+            }
+        }
         const auto limit = context["Limit"].maybe<int64_t>();
         if (limit) {
             options.limit(*limit);
@@ -56,36 +60,20 @@ struct MultiCollectionQuery::PhaseConfig {
         }
     }
 
-    mongocxx::database database;
-    int64_t numCollections;
+    CollectionSelector collections;
+    std::optional<mongocxx::read_concern> readConcern;
     DocumentGenerator filterExpr;
-
-    // uniform distribution random int for selecting collection
-    std::uniform_int_distribution<int64_t> uniformDistribution;
     mongocxx::options::find options;
-    std::optional<mongocxx::read_concern> readConcern;
 };
 
 void MultiCollectionQuery::run() {
     for (auto&& config : _loop) {
         for (auto&& _ : config) {
-            // Select a collection
-            // This area is ripe for defining a collection generator, based off a string generator.
-            // It could look like: collection: {^Concat: [Collection, ^RandomInt: {min: 0, max:
-            // *CollectionCount]} Requires a string concat generator, and a translation of a string
-            // to a collection
-            auto collectionNumber = config->uniformDistribution(_rng);
-            auto collectionName = "Collection" + std::to_string(collectionNumber);
-            auto collection = config->database[collectionName];
-
-            if (config->readConcern) {
-                collection.read_concern(*config->readConcern);
-            }
+            auto& collection = config->collections(_rng);
 
             // Perform a query
             auto filter = config->filterExpr();
             // BOOST_LOG_TRIVIAL(info) << "Filter is " <<  bsoncxx::to_json(filter.view());
-            // BOOST_LOG_TRIVIAL(info) << "Collection Name is " << collectionName;
             {
                 // Only time the actual update, not the setup of arguments
                 auto opCtx = _queryOp.start();
@@ -29,6 +29,7 @@
 #include <boost/log/trivial.hpp>
 
 #include <gennylib/Cast.hpp>
+#include <gennylib/CollectionSelector.hpp>
 #include <gennylib/context.hpp>
 
 #include <value_generators/DocumentGenerator.hpp>
@@ -38,40 +39,30 @@ namespace genny::actor {
 /** @private */
 struct MultiCollectionUpdate::PhaseConfig {
     PhaseConfig(PhaseContext& context, mongocxx::pool::entry& client, ActorId id)
-        : database{(*client)[context["Database"].to<std::string>()]},
-          numCollections{context["CollectionCount"].to<IntegerSpec>()},
+        : collections{context, (*client)[context["Database"].to<std::string>()], id},
           queryExpr{context["UpdateFilter"].to<DocumentGenerator>(context, id)},
           updateExpr{context["Update"].to<DocumentGenerator>(context, id)},
-          uniformDistribution{0, numCollections - 1},
           updateOperation{context.operation("Update", id)} {}
 
-    mongocxx::database database;
-    int64_t numCollections;
+    CollectionSelector collections;
     DocumentGenerator queryExpr;
     DocumentGenerator updateExpr;
     // TODO: Enable passing in update options.
     //    DocumentGenerator  updateOptionsExpr;
 
-    // uniform distribution random int for selecting collection
-    std::uniform_int_distribution<int64_t> uniformDistribution;
-
     metrics::Operation updateOperation;
 };
 
 void MultiCollectionUpdate::run() {
     for (auto&& config : _loop) {
         for (auto&& _ : config) {
-            // Select a collection
-            auto collectionNumber = config->uniformDistribution(_rng);
-            auto collectionName = "Collection" + std::to_string(collectionNumber);
-            auto collection = config->database[collectionName];
+            auto& collection = config->collections(_rng);
 
             // Perform update
             auto filter = config->queryExpr();
             auto update = config->updateExpr();
             // BOOST_LOG_TRIVIAL(info) << "Filter is " <<  bsoncxx::to_json(filter.view());
             // BOOST_LOG_TRIVIAL(info) << "Update is " << bsoncxx::to_json(update.view());
-            // BOOST_LOG_TRIVIAL(info) << "Collection Name is " << collectionName;
             {
                 // Only time the actual update, not the setup of arguments
                 auto opCtx = config->updateOperation.start();
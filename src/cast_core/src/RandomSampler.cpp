@@ -28,6 +28,7 @@
 #include <boost/throw_exception.hpp>
 
 #include <gennylib/Cast.hpp>
+#include <gennylib/CollectionSelector.hpp>
 #include <gennylib/MongoException.hpp>
 #include <gennylib/context.hpp>
 
@@ -36,8 +37,7 @@
 namespace genny::actor {
 
 struct RandomSampler::PhaseConfig {
-    std::vector<mongocxx::collection> collections;
-    boost::random::uniform_int_distribution<> integerDistribution;
+    CollectionSelector collections;
     /*
      * Two separate trackers as we want to be able to observe the impact
      * of the collection scanner on the read throughput.
@@ -51,19 +51,15 @@ struct RandomSampler::PhaseConfig {
                 const mongocxx::database& db,
                 int collectionCount,
                 int threads)
-        : readOperation{context.operation("Read", actor->id())},
+        : collections{context,
+                      db,
+                      // Distribute the collections among the actors.
+                      distributeCollectionNames(collectionCount, threads, actor->_index),
+                      actor->id()},
+          readOperation{context.operation("Read", actor->id())},
           readWithScanOperation{context.operation("ReadWithScan", actor->id())} {
         // Construct basic pipeline for retrieving 10 random records.
         pipeline.sample(10);
-
-        // Distribute the collections among the actors.
-        for (const auto& collectionName :
-             distributeCollectionNames(collectionCount, threads, actor->_index)) {
-            collections.push_back(db[collectionName]);
-        }
-        // Setup the int distribution.
-        integerDistribution =
-            boost::random::uniform_int_distribution(0, (int)collections.size() - 1);
     }
 };
 
@@ -73,9 +69,8 @@ void RandomSampler::run() {
             auto statTracker = _activeCollectionScannerInstances > 0
                 ? config->readWithScanOperation.start()
                 : config->readOperation.start();
-            int index = config->collections.size() > 1 ? config->integerDistribution(_random) : 0;
-            auto cursor = config->collections[index].aggregate(config->pipeline,
-                                                               mongocxx::options::aggregate{});
+            auto cursor = config->collections(_random).aggregate(config->pipeline,
+                                                                 mongocxx::options::aggregate{});
             for (auto doc : cursor) {
                 statTracker.addDocuments(1);
                 statTracker.addBytes(doc.length());
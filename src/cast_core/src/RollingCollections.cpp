@@ -154,9 +154,14 @@ struct Write : public RunOperation {
             return;
         }
         auto collectionName = rollingCollectionNames.back();
+        // Writes go to the newest collection until Manage creates the next one, so keep its
+        // handle rather than building one for every insert.
+        if (!_collection || collectionName != _collectionName) {
+            _collection = database[collectionName];
+            _collectionName = std::move(collectionName);
+        }
         try {
-            auto collection = database[collectionName];
-            collection.insert_one(document.view());
+            _collection->insert_one(document.view());
             statTracker.addDocuments(1);
             statTracker.addBytes(document.view().length());
             statTracker.success();
@@ -169,6 +174,8 @@ struct Write : public RunOperation {
 private:
     DocumentGenerator _documentExpr;
     metrics::Operation _insertOperation;
+    std::string _collectionName;
+    std::optional<mongocxx::collection> _collection;
 };
 
 struct Setup : public RunOperation {
@@ -159,8 +159,7 @@ public:
     };
 
     void run() {
-        auto command = _commandExpr();
-        auto view = command.view();
+        auto view = _commandExpr.evaluateInto(_commandBuffer);
 
         if (!_options.isQuiet) {
             BOOST_LOG_TRIVIAL(info) << " Running command: " << bsoncxx::to_json(view)
@@ -202,6 +201,7 @@ private:
     std::string _databaseName;
     mongocxx::database _database;
     DocumentGenerator _commandExpr;
+    DocumentGenerator::Buffer _commandBuffer;
     OpConfig _options;
 
     std::optional<metrics::Operation> _operation;
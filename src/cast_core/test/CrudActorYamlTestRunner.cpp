@@ -147,7 +147,10 @@ void requireOutcomeCounts(mongocxx::pool::entry& client, YAML::Node outcomeCount
     }
 }
 
-NodeSource createConfigurationYaml(YAML::Node operations) {
+// Keys of a test case that are copied into the phase as they are.
+const char* PHASE_KEYS[] = {"PreGenerate", "OperationSelection", "Repeat"};
+
+NodeSource createConfigurationYaml(YAML::Node operations, YAML::Node tcase) {
     YAML::Node config = YAML::Load(R"(
           SchemaVersion: 2018-07-01
           Actors:
@@ -161,6 +164,11 @@ NodeSource createConfigurationYaml(YAML::Node operations) {
     config["Actors"][0]["Database"] = DEFAULT_DB;
     config["Actors"][0]["Phases"][0]["Collection"] = DEFAULT_COLLECTION;
     config["Actors"][0]["Phases"][0]["Operations"] = operations;
+    for (auto key : PHASE_KEYS) {
+        if (tcase[key]) {
+            config["Actors"][0]["Phases"][0][key] = tcase[key];
+        }
+    }
     return NodeSource{YAML::Dump(config), "operationsConfig"};
 }
 
@@ -198,7 +206,7 @@ struct CrudActorTestCase {
             auto events = ApmEvents{};
             auto apmCallback = makeApmCallback(events);
 
-            auto config = createConfigurationYaml(operations);
+            auto config = createConfigurationYaml(operations, tcase);
             {
                 std::stringstream str;
                 str << config.root();
@@ -54,7 +54,7 @@ TEST_CASE_METHOD(MongoTestFixture, "MultiCollectionQuery", "[standalone][MultiCo
                                  "");
 
         try {
-            auto coll = db.collection("Collection1");
+            auto coll = db.collection("Collection0");
             coll.insert_one(BasicBson::make_document(BasicBson::kvp("a", 1)));
             coll.insert_one(BasicBson::make_document(BasicBson::kvp("a", 2)));
 
@@ -15,6 +15,7 @@
 #ifndef HEADER_81A374DA_8E23_4E4D_96D2_619F27016F2A_INCLUDED
 #define HEADER_81A374DA_8E23_4E4D_96D2_619F27016F2A_INCLUDED
 
+#include <chrono>
 #include <optional>
 #include <string>
 #include <vector>
@@ -23,12 +24,14 @@
 
 #include <gennylib/ActorProducer.hpp>
 #include <gennylib/ActorVector.hpp>
+#include <gennylib/v1/CoarseClock.hpp>
 #include <metrics/metrics.hpp>
 
 namespace genny::driver {
 
 /**
- * Basic workload driver that spins up one thread per actor.
+ * Basic workload driver that spins up one thread per actor, or runs all actors on a
+ * fixed-size pool of threads when `ProgramOptions::actorThreads` is set.
  */
 class DefaultDriver {
 public:
@@ -66,6 +69,21 @@ public:
         std::string mongoUri;
         std::string description;
         bool isSmokeTest;
+
+        // Number of worker threads to multiplex actors onto. 0 means one thread per actor.
+        std::size_t actorThreads = 0;
+
+        // Number of processes to split the actors between. See v1::WorkerGroup.
+        std::size_t workers = 1;
+
+        // CPUs to run actor threads on, in v1::CpuSet syntax. Empty means no pinning.
+        std::string cpuAffinity;
+        // CPUs to run metrics and connection-pool background threads on. Empty means no pinning.
+        std::string metricsCpuAffinity;
+
+        // Time source for Duration checks. See v1::CoarseClock.
+        genny::v1::CoarseClock::Mode clockSource = genny::v1::CoarseClock::Mode::kPrecise;
+        std::chrono::microseconds clockTickerResolution{100};
         DefaultDriver::RunMode runMode = RunMode::kNormal;
         boost::log::trivial::severity_level logVerbosity;
     };
@@ -13,10 +13,21 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <optional>
 #include <sstream>
+#include <system_error>
 #include <thread>
 #include <vector>
 
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/exception/exception.hpp>
 #include <boost/filesystem.hpp>
@@ -31,6 +42,10 @@
 
 #include <gennylib/Cast.hpp>
 #include <gennylib/context.hpp>
+#include <gennylib/v1/ActorScheduler.hpp>
+#include <gennylib/v1/CoarseClock.hpp>
+#include <gennylib/v1/CpuAffinity.hpp>
+#include <gennylib/v1/WorkerGroup.hpp>
 
 #include <metrics/MetricsReporter.hpp>
 #include <metrics/metrics.hpp>
@@ -46,10 +61,14 @@ namespace fs = boost::filesystem;
 template <typename Actor>
 void runActor(Actor&& actor,
               std::atomic<driver::DefaultDriver::OutcomeCode>& outcomeCode,
-              Orchestrator& orchestrator) {
+              Orchestrator& orchestrator,
+              const std::optional<genny::v1::CpuSet>& cpuSet) {
     auto guard = Loki::MakeGuard([&]() { orchestrator.abort(); });
 
     try {
+        if (cpuSet) {
+            cpuSet->pinCurrentThread();
+        }
         actor->run();
     } catch (const boost::exception& x) {
         BOOST_LOG_TRIVIAL(error) << "Unexpected boost::exception: "
@@ -65,6 +84,34 @@ void runActor(Actor&& actor,
     }
 }
 
+/**
+ * Record where each kind of thread was allowed to run so runs can be reproduced.
+ * Written next to the other metrics output as `<Metrics.Path>-cpu-placement.csv`, or
+ * `<Metrics.Path>-worker<N>-cpu-placement.csv` for each of several workers.
+ */
+void reportPlacements(const std::string& pathPrefix,
+                      const WorkloadContext& workloadContext,
+                      const std::optional<genny::v1::CpuSet>& metricsCpuSet,
+                      const std::optional<genny::v1::CpuSet>& actorCpuSet,
+                      bool perActorPlacement) {
+    std::ofstream out;
+    out.open(pathPrefix + "-cpu-placement.csv",
+             std::ofstream::out | std::ofstream::trunc);
+    out << "Thread,ActorId,Cpus" << std::endl;
+    if (metricsCpuSet) {
+        out << "metrics,," << metricsCpuSet->toString() << std::endl;
+    }
+    for (const auto& actor : workloadContext.actors()) {
+        auto cpuSet = perActorPlacement ? workloadContext.cpuSetFor(actor->id()) : std::nullopt;
+        if (!cpuSet) {
+            cpuSet = actorCpuSet;
+        }
+        if (cpuSet) {
+            out << "actor," << actor->id() << "," << cpuSet->toString() << std::endl;
+        }
+    }
+}
+
 void reportMetrics(genny::metrics::Registry& metrics,
                    const std::string& workloadName,
                    bool success,
@@ -79,6 +126,375 @@ void reportMetrics(genny::metrics::Registry& metrics,
     actorSetup.report(std::move(finishTime), std::move(duration), std::move(outcome));
 }
 
+/**
+ * @return the `Metrics.Path` the WorkloadContext will use, without constructing one.
+ */
+std::string metricsPathPrefix(const YAML::Node& yaml) {
+    if (const auto metrics = yaml["Metrics"]; metrics && metrics["Path"]) {
+        return metrics["Path"].as<std::string>();
+    }
+    // Same default as the WorkloadContext.
+    return "build/CedarMetrics";
+}
+
+/**
+ * @return the prefix for files this process writes itself rather than through the
+ * metrics Registry. Workers each get their own so they don't clobber each other.
+ */
+std::string outputPrefix(const genny::metrics::Registry& metrics,
+                         const genny::v1::WorkerGroup* workerGroup) {
+    auto prefix = metrics.getPathPrefix().string();
+    if (workerGroup) {
+        prefix += "-worker" + std::to_string(workerGroup->index());
+    }
+    return prefix;
+}
+
+void flushOutput() {
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+}
+
+using WorkerFn = std::function<DefaultDriver::OutcomeCode()>;
+
+/**
+ * Fork one process per member of `workerGroup` that each call `runWorker`, and wait for them.
+ * If any worker fails, the others are aborted.
+ *
+ * @return the outcome of the first worker to fail, if any.
+ */
+DefaultDriver::OutcomeCode runWorkers(genny::v1::WorkerGroup& workerGroup,
+                                      const WorkerFn& runWorker) {
+    // Otherwise every worker would inherit and print whatever is still buffered.
+    flushOutput();
+
+    std::vector<pid_t> workers;
+    for (size_t i = 0; i < workerGroup.size(); ++i) {
+        const pid_t pid = fork();
+        if (pid == 0) {
+            workerGroup.joinAs(i);
+            auto outcome = DefaultDriver::OutcomeCode::kInternalException;
+            try {
+                outcome = runWorker();
+            } catch (const boost::exception& x) {
+                BOOST_LOG_TRIVIAL(error) << "Caught boost::exception in worker " << i << ": "
+                                         << boost::diagnostic_information(x, true);
+            } catch (const std::exception& x) {
+                BOOST_LOG_TRIVIAL(error) << "Caught std::exception in worker " << i << ": "
+                                         << x.what();
+            }
+            flushOutput();
+            // Don't run the atexit handlers and static destructors that belong to the parent.
+            _exit(static_cast<int>(outcome));
+        }
+        if (pid < 0) {
+            const int err = errno;
+            workerGroup.abort();
+            for (const auto worker : workers) {
+                waitpid(worker, nullptr, 0);
+            }
+            BOOST_THROW_EXCEPTION(
+                std::system_error(err, std::generic_category(), "Could not fork worker"));
+        }
+        workers.push_back(pid);
+    }
+    BOOST_LOG_TRIVIAL(info) << "Started " << workers.size() << " worker processes";
+
+    // Poll only our own workers rather than waitpid(-1), which would also reap children that
+    // other code in this process started. Polling also notices a worker that dies while the
+    // others are blocked waiting for it at a phase barrier.
+    auto outcome = DefaultDriver::OutcomeCode::kSuccess;
+    while (!workers.empty()) {
+        for (auto it = workers.begin(); it != workers.end();) {
+            int status = 0;
+            const pid_t pid = waitpid(*it, &status, WNOHANG);
+            if (pid == 0 || (pid < 0 && errno == EINTR)) {
+                ++it;
+                continue;
+            }
+            if (pid < 0) {
+                BOOST_THROW_EXCEPTION(std::system_error(
+                    errno, std::generic_category(), "Could not wait for workers"));
+            }
+            it = workers.erase(it);
+
+            const auto workerOutcome = WIFEXITED(status)
+                ? static_cast<DefaultDriver::OutcomeCode>(WEXITSTATUS(status))
+                : DefaultDriver::OutcomeCode::kUnknownException;
+            if (workerOutcome != DefaultDriver::OutcomeCode::kSuccess) {
+                BOOST_LOG_TRIVIAL(error) << "Worker process " << pid << " failed with status "
+                                         << status << ". Stopping the other workers.";
+                workerGroup.abort();
+                if (outcome == DefaultDriver::OutcomeCode::kSuccess) {
+                    outcome = workerOutcome;
+                }
+            }
+        }
+        if (!workers.empty()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        }
+    }
+    return outcome;
+}
+
+/**
+ * How mergeWorkerMetrics() combines one section of the csv written by metrics::Reporter.
+ */
+struct CsvSection {
+    // Every worker constructs every actor, so these sections are the same in each worker's
+    // file. Only the first worker's copy is kept.
+    bool sameInEveryWorker;
+    // Lines after the section's title that name the columns.
+    size_t columnHeaderLines;
+};
+
+// Keyed by section title. Covers the "csv", "cedar-csv" and "csv-ftdc" formats.
+const std::map<std::string, CsvSection> kCsvSections = {
+    {"Clocks", {true, 0}},
+    {"Counters", {false, 0}},
+    {"Gauges", {false, 0}},
+    {"Timers", {false, 0}},
+    {"OperationThreadCounts", {true, 1}},
+    {"Operations", {false, 1}},
+};
+
+/**
+ * Combine the `<pathPrefix>-worker<N>.csv` files written by each worker into `<pathPrefix>.csv`.
+ *
+ * Each file is a series of sections separated by blank lines. A section is a title line, any
+ * column header lines, and then rows. Rows of event sections are concatenated. See
+ * kCsvSections.
+ */
+void mergeWorkerMetrics(const std::string& pathPrefix, size_t workers) {
+    // A title line followed by that section's lines.
+    using Section = std::vector<std::string>;
+    std::vector<Section> merged;
+    bool anyWorkerFiles = false;
+
+    for (size_t i = 0; i < workers; ++i) {
+        const auto workerPath = pathPrefix + "-worker" + std::to_string(i) + ".csv";
+        std::ifstream in{workerPath};
+        if (!in) {
+            continue;
+        }
+
+        std::vector<Section> sections{Section{}};
+        for (std::string line; std::getline(in, line);) {
+            if (line.empty()) {
+                sections.emplace_back();
+            } else {
+                sections.back().push_back(std::move(line));
+            }
+        }
+        in.close();
+        fs::remove(workerPath);
+
+        for (auto& section : sections) {
+            if (section.empty()) {
+                continue;
+            }
+            const auto& title = section.front();
+            auto existing = std::find_if(merged.begin(), merged.end(), [&](const Section& m) {
+                return m.front() == title;
+            });
+            if (existing == merged.end()) {
+                merged.push_back(std::move(section));
+                continue;
+            }
+            const auto format = kCsvSections.find(title);
+            if (format == kCsvSections.end()) {
+                BOOST_LOG_TRIVIAL(warning) << "Keeping only the first worker's rows of unknown "
+                                              "metrics section "
+                                           << title;
+                continue;
+            }
+            if (format->second.sameInEveryWorker) {
+                continue;
+            }
+            const auto skip = std::min(section.size(), 1 + format->second.columnHeaderLines);
+            existing->insert(existing->end(), section.begin() + skip, section.end());
+        }
+        anyWorkerFiles = true;
+    }
+
+    if (!anyWorkerFiles) {
+        return;
+    }
+    std::ofstream out{pathPrefix + ".csv", std::ofstream::out | std::ofstream::trunc};
+    for (const auto& section : merged) {
+        for (const auto& line : section) {
+            out << line << std::endl;
+        }
+        out << std::endl;
+    }
+}
+
+/**
+ * Run the actors of a parsed workload in this process.
+ *
+ * @param workerGroup if set, this process is one of several workers. It runs every
+ * `workerGroup->size()`th actor and changes phases together with the other workers.
+ */
+DefaultDriver::OutcomeCode runWorkload(const DefaultDriver::ProgramOptions& options,
+                                       const YAML::Node& yaml,
+                                       const std::string& workloadName,
+                                       metrics::clock::time_point startTime,
+                                       genny::v1::WorkerGroup* workerGroup) {
+    auto orchestrator = Orchestrator{};
+
+    NodeSource nodeSource{YAML::Dump(yaml),
+                          options.workloadSourceType ==
+                                  DefaultDriver::ProgramOptions::YamlSource::kFile
+                              ? options.workloadSource
+                              : "inline-yaml"};
+
+
+    // Threads inherit the affinity of the thread that creates them. Pin this thread before
+    // building the WorkloadContext so the metrics and connection-pool threads it starts stay on
+    // the metrics cpus. Actor threads re-pin themselves below.
+    const auto initialCpuSet = genny::v1::CpuSet::ofCurrentThread();
+    // Give the caller its own placement back once the workload is done, even if it throws.
+    auto restoreCpuSet = Loki::MakeGuard([&]() { initialCpuSet.pinCurrentThread(); });
+    std::optional<genny::v1::CpuSet> metricsCpuSet;
+    if (!options.metricsCpuAffinity.empty()) {
+        metricsCpuSet.emplace(options.metricsCpuAffinity);
+        metricsCpuSet->pinCurrentThread();
+    }
+    std::optional<genny::v1::CpuSet> actorCpuSet;
+    if (!options.cpuAffinity.empty()) {
+        actorCpuSet.emplace(options.cpuAffinity);
+    } else if (metricsCpuSet) {
+        actorCpuSet = initialCpuSet;
+    }
+
+    // Rate limiters are created while constructing the WorkloadContext, so join first.
+    if (workerGroup) {
+        orchestrator.joinWorkerGroup(*workerGroup);
+    }
+
+    auto workloadContext =
+        WorkloadContext{nodeSource.root(), orchestrator, options.mongoUri, globalCast()};
+
+    genny::metrics::Registry& metrics = workloadContext.getMetrics();
+
+    if (options.runMode == DefaultDriver::RunMode::kDryRun) {
+        std::cout << "Workload context constructed without errors." << std::endl;
+        reportMetrics(metrics, workloadName, true, startTime);
+        return DefaultDriver::OutcomeCode::kSuccess;
+    }
+
+    reportMetrics(metrics, workloadName, true, startTime);
+
+    // The "ActorStarted" and "ActorFinished" operations are genny internal operations. We want the
+    // trend graph to be hidden by default to not confuse users, so we prefix them with "canary_"
+    // to hit the CANARY_EXCLUSION_REGEX in https://git.io/Jtjdr
+    auto startedActors = metrics.operation("canary_" + workloadName, "ActorStarted", 0u);
+    auto finishedActors = metrics.operation("canary_" + workloadName, "ActorFinished", 0u);
+
+    std::atomic<DefaultDriver::OutcomeCode> outcomeCode = DefaultDriver::OutcomeCode::kSuccess;
+
+    // Actors running on an ActorScheduler share worker threads, so only the workload-wide
+    // placement applies to them.
+    const bool perActorPlacement = options.actorThreads == 0;
+    const bool anyActorCpuSet = std::any_of(
+        cbegin(workloadContext.actors()), cend(workloadContext.actors()), [&](const auto& actor) {
+            return workloadContext.cpuSetFor(actor->id()).has_value();
+        });
+    if (!perActorPlacement && anyActorCpuSet) {
+        BOOST_LOG_TRIVIAL(warning)
+            << "Ignoring per-Actor CpuSet because actors share --actor-threads worker threads. "
+               "Use --cpu-affinity instead.";
+    }
+    if (metricsCpuSet || actorCpuSet || (perActorPlacement && anyActorCpuSet)) {
+        reportPlacements(outputPrefix(metrics, workerGroup),
+                         workloadContext,
+                         metricsCpuSet,
+                         actorCpuSet,
+                         perActorPlacement);
+    }
+
+    // Started after setup so a ticker thread inherits the metrics placement.
+    genny::v1::CoarseClock::Source clockSource{options.clockSource, options.clockTickerResolution};
+
+    std::mutex reporting;
+    auto makeTask = [&](const auto& actor) -> genny::v1::ActorScheduler::Task {
+        return [&]() {
+            {
+                auto ctx = startedActors.start();
+                ctx.addDocuments(1);
+
+                std::lock_guard<std::mutex> lk{reporting};
+                ctx.success();
+            }
+
+            auto cpuSet =
+                perActorPlacement ? workloadContext.cpuSetFor(actor->id()) : std::nullopt;
+            runActor(actor, outcomeCode, orchestrator, cpuSet ? cpuSet : actorCpuSet);
+
+            {
+                auto ctx = finishedActors.start();
+                ctx.addDocuments(1);
+
+                std::lock_guard<std::mutex> lk{reporting};
+                ctx.success();
+            }
+        };
+    };
+
+    // Every worker constructs every actor so ActorIds and random seeds don't depend on the
+    // number of workers, but each one only runs its share.
+    std::vector<genny::v1::ActorScheduler::Task> tasks;
+    size_t actorIndex = 0;
+    for (const auto& actor : workloadContext.actors()) {
+        if (!workerGroup || actorIndex++ % workerGroup->size() == workerGroup->index()) {
+            tasks.push_back(makeTask(actor));
+        }
+    }
+    if (workerGroup && tasks.empty()) {
+        // There are more workers than actors. This one still has to take part in every phase
+        // change or the others would wait for it forever.
+        tasks.push_back([&]() {
+            while (orchestrator.morePhases()) {
+                orchestrator.awaitPhaseStart();
+                orchestrator.awaitPhaseEnd();
+            }
+        });
+    }
+    orchestrator.addRequiredTokens(int(tasks.size()));
+
+    if (options.actorThreads > 0) {
+        BOOST_LOG_TRIVIAL(info) << "Running " << tasks.size() << " actors on "
+                                << options.actorThreads << " threads";
+        // Worker threads inherit this placement.
+        if (actorCpuSet) {
+            actorCpuSet->pinCurrentThread();
+        }
+        genny::v1::ActorScheduler{options.actorThreads}.run(std::move(tasks));
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(tasks.size());
+        for (auto& task : tasks) {
+            threads.emplace_back(std::move(task));
+        }
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    if (metrics.getFormat().useCsv()) {
+        const auto reporter = genny::metrics::Reporter{metrics};
+
+        {
+            std::ofstream metricsOutput;
+            metricsOutput.open(outputPrefix(metrics, workerGroup) + ".csv",
+                               std::ofstream::out | std::ofstream::trunc);
+            reporter.report(metricsOutput, metrics.getFormat());
+        }
+    }
+
+    return outcomeCode;
+}
+
 DefaultDriver::OutcomeCode doRunLogic(const DefaultDriver::ProgramOptions& options) {
     // setup logging as the first thing we do.
     boost::log::core::get()->set_filter(boost::log::trivial::severity >= options.logVerbosity);
@@ -124,8 +540,6 @@ DefaultDriver::OutcomeCode doRunLogic(const DefaultDriver::ProgramOptions& optio
                              options.isSmokeTest ? v1::WorkloadParser::Mode::kSmokeTest
                                                  : v1::WorkloadParser::Mode::kNormal);
 
-    auto orchestrator = Orchestrator{};
-
     if (options.runMode == DefaultDriver::RunMode::kEvaluate) {
         std::cout << YAML::Dump(yaml) << std::endl;
         genny::metrics::Registry metrics;
@@ -133,79 +547,17 @@ DefaultDriver::OutcomeCode doRunLogic(const DefaultDriver::ProgramOptions& optio
         return DefaultDriver::OutcomeCode::kSuccess;
     }
 
-    NodeSource nodeSource{YAML::Dump(yaml),
-                          options.workloadSourceType ==
-                                  DefaultDriver::ProgramOptions::YamlSource::kFile
-                              ? options.workloadSource
-                              : "inline-yaml"};
-
-
-    auto workloadContext =
-        WorkloadContext{nodeSource.root(), orchestrator, options.mongoUri, globalCast()};
-
-    genny::metrics::Registry& metrics = workloadContext.getMetrics();
-
-    if (options.runMode == DefaultDriver::RunMode::kDryRun) {
-        std::cout << "Workload context constructed without errors." << std::endl;
-        reportMetrics(metrics, workloadName, true, startTime);
-        return DefaultDriver::OutcomeCode::kSuccess;
-    }
-
-    orchestrator.addRequiredTokens(
-        int(std::distance(workloadContext.actors().begin(), workloadContext.actors().end())));
-
-    reportMetrics(metrics, workloadName, true, startTime);
-
-    // The "ActorStarted" and "ActorFinished" operations are genny internal operations. We want the
-    // trend graph to be hidden by default to not confuse users, so we prefix them with "canary_"
-    // to hit the CANARY_EXCLUSION_REGEX in https://git.io/Jtjdr
-    auto startedActors = metrics.operation("canary_" + workloadName, "ActorStarted", 0u);
-    auto finishedActors = metrics.operation("canary_" + workloadName, "ActorFinished", 0u);
-
-    std::atomic<DefaultDriver::OutcomeCode> outcomeCode = DefaultDriver::OutcomeCode::kSuccess;
-
-    std::mutex reporting;
-    std::vector<std::thread> threads;
-    std::transform(cbegin(workloadContext.actors()),
-                   cend(workloadContext.actors()),
-                   std::back_inserter(threads),
-                   [&](const auto& actor) {
-                       return std::thread{[&]() {
-                           {
-                               auto ctx = startedActors.start();
-                               ctx.addDocuments(1);
-
-                               std::lock_guard<std::mutex> lk{reporting};
-                               ctx.success();
-                           }
-
-                           runActor(actor, outcomeCode, orchestrator);
-
-                           {
-                               auto ctx = finishedActors.start();
-                               ctx.addDocuments(1);
-
-                               std::lock_guard<std::mutex> lk{reporting};
-                               ctx.success();
-                           }
-                       }};
-                   });
-
-    for (auto& thread : threads)
-        thread.join();
-
-    if (metrics.getFormat().useCsv()) {
-        const auto reporter = genny::metrics::Reporter{metrics};
-
-        {
-            std::ofstream metricsOutput;
-            metricsOutput.open(metrics.getPathPrefix().string() + ".csv",
-                               std::ofstream::out | std::ofstream::trunc);
-            reporter.report(metricsOutput, metrics.getFormat());
-        }
+    if (options.workers > 1 && options.runMode == DefaultDriver::RunMode::kNormal) {
+        // Created before forking so every worker shares it.
+        genny::v1::WorkerGroup workerGroup{options.workers};
+        const auto outcome = runWorkers(workerGroup, [&]() {
+            return runWorkload(options, yaml, workloadName, startTime, &workerGroup);
+        });
+        mergeWorkerMetrics(metricsPathPrefix(yaml), options.workers);
+        return outcome;
     }
 
-    return outcomeCode;
+    return runWorkload(options, yaml, workloadName, startTime, nullptr);
 }
 
 }  // namespace
@@ -269,6 +621,20 @@ boost::log::trivial::severity_level parseVerbosity(const std::string& level) {
                                 "'. Need one of trace/debug/info/warning/error/fatal");
 }
 
+genny::v1::CoarseClock::Mode parseClockSource(const std::string& source) {
+    if (source == "precise") {
+        return genny::v1::CoarseClock::Mode::kPrecise;
+    }
+    if (source == "coarse") {
+        return genny::v1::CoarseClock::Mode::kKernel;
+    }
+    if (source == "ticker") {
+        return genny::v1::CoarseClock::Mode::kTicker;
+    }
+    throw std::invalid_argument("Invalid clock source '" + source +
+                                "'. Need one of precise/coarse/ticker");
+}
+
 }  // namespace
 
 const std::string RUNNER_NAME = "genny";
@@ -312,7 +678,35 @@ DefaultDriver::ProgramOptions::ProgramOptions(int argc, char** argv) {
               "Log severity for boost logging. Valid values are trace/debug/info/warning/error/fatal.")
             ("smoke-test,s",
              po::value<bool>()->default_value(false),
-             "Run a workload in smoke test mode where all phases are set to Repeat=1");
+             "Run a workload in smoke test mode where all phases are set to Repeat=1")
+            ("actor-threads",
+             po::value<std::size_t>()->default_value(0),
+             "Run all actors on this many worker threads instead of one thread per actor. "
+             "Actors take turns at PhaseLoop iteration boundaries, rate-limit waits, and "
+             "phase changes. 0 gives each actor its own thread.")
+            ("workers",
+             po::value<std::size_t>()->default_value(1),
+             "Fork this many worker processes. Each runs an equal share of the actors, phases "
+             "start and end in all of them together, and GlobalRate limits apply across all of "
+             "them. csv metrics are merged into one file at the end.")
+            ("cpu-affinity",
+             po::value<std::string>()->default_value(""),
+             "Pin actor threads to these cpus, e.g. '0-15', '0,2,4' or 'node0' for every cpu on "
+             "NUMA node 0. An Actor's 'CpuSet:' key overrides this for its own threads.")
+            ("metrics-cpu-affinity",
+             po::value<std::string>()->default_value(""),
+             "Pin metrics and connection-pool background threads to these cpus. Same syntax as "
+             "--cpu-affinity.")
+            ("clock-source",
+             po::value<std::string>()->default_value("precise"),
+             "Clock used to check whether a Phase's Duration has elapsed. 'precise' reads the "
+             "steady clock every iteration. 'coarse' reads CLOCK_MONOTONIC_COARSE, which is "
+             "cheaper but only accurate to the kernel tick. 'ticker' reads a value that one "
+             "background thread updates every --clock-ticker-resolution. Phases never end "
+             "early; the cheaper clocks may end them up to one tick late.")
+            ("clock-ticker-resolution",
+             po::value<long>()->default_value(100),
+             "Microseconds between updates of the 'ticker' clock source.");
 
     positional.add("subcommand", 1);
     positional.add("workload-file", -1);
@@ -361,6 +755,16 @@ DefaultDriver::ProgramOptions::ProgramOptions(int argc, char** argv) {
 
     this->logVerbosity = parseVerbosity(vm["verbosity"].as<std::string>());
     this->isSmokeTest = vm["smoke-test"].as<bool>();
+    this->actorThreads = vm["actor-threads"].as<std::size_t>();
+    this->workers = vm["workers"].as<std::size_t>();
+    this->cpuAffinity = vm["cpu-affinity"].as<std::string>();
+    this->metricsCpuAffinity = vm["metrics-cpu-affinity"].as<std::string>();
+    this->clockSource = parseClockSource(vm["clock-source"].as<std::string>());
+    this->clockTickerResolution =
+        std::chrono::microseconds{vm["clock-ticker-resolution"].as<long>()};
+    if (this->clockTickerResolution.count() <= 0) {
+        throw std::invalid_argument("--clock-ticker-resolution must be positive");
+    }
     this->mongoUri = vm["mongo-uri"].as<std::string>();
 
     if (vm.count("workload-file") > 0) {
@@ -137,7 +137,9 @@ DefaultDriver::ProgramOptions create(const std::string& yaml) {
     return opts;
 }
 
-std::pair<DefaultDriver::OutcomeCode, std::string> outcome(const std::string& yaml) {
+std::pair<DefaultDriver::OutcomeCode, std::string> outcome(const std::string& yaml,
+                                                           std::size_t actorThreads = 0,
+                                                           std::size_t workers = 1) {
     Fails::state.clear();
 
     boost::filesystem::path ph =
@@ -153,6 +155,8 @@ std::pair<DefaultDriver::OutcomeCode, std::string> outcome(const std::string& ya
         )";
     DefaultDriver driver;
     auto opts = create(yaml + metricsSection);
+    opts.actorThreads = actorThreads;
+    opts.workers = workers;
     return {driver.run(opts), metricsPath + ".csv"};
 }
 
@@ -298,6 +302,110 @@ TEST_CASE("Various Actor Behaviors") {
         REQUIRE(hasMetrics(opts));
     }
 
+    SECTION("1000 Actors on 4 threads") {
+        auto [code, opts] = outcome(R"(
+        SchemaVersion: 2018-07-01
+        Actors:
+        - Type: Fails
+          Name: Fails
+          Threads: 1000
+          Phases:
+            - Repeat: 5
+              Mode: NoException
+            - Repeat: 5
+              Mode: NoException
+        )",
+                                    4);
+
+        REQUIRE(code == DefaultDriver::OutcomeCode::kSuccess);
+        REQUIRE(Fails::state.reachedPhases().count(0) == 5000);
+        REQUIRE(Fails::state.reachedPhases().count(1) == 5000);
+        REQUIRE(hasMetrics(opts));
+    }
+
+    SECTION("200 Actors on 2 threads simultaneously throw") {
+        auto [code, opts] = outcome(R"(
+        SchemaVersion: 2018-07-01
+        Actors:
+        - Type: Fails
+          Name: Fails
+          Threads: 200
+          Phases:
+            - Repeat: 1
+              Mode: StdException
+        )",
+                                    2);
+
+        REQUIRE(code == DefaultDriver::OutcomeCode::kStandardException);
+        REQUIRE(Fails::state.reachedPhases().size() > 0);
+        REQUIRE(hasMetrics(opts));
+    }
+
+    // Fails::state is per-process, so these can only check outcomes and metrics.
+    SECTION("Actors split between 3 workers") {
+        auto [code, opts] = outcome(R"(
+        SchemaVersion: 2018-07-01
+        Actors:
+        - Type: Fails
+          Name: Fails
+          Threads: 10
+          Phases:
+            - Repeat: 5
+              Mode: NoException
+            - Repeat: 5
+              Mode: NoException
+        )",
+                                    0,
+                                    3);
+
+        REQUIRE(code == DefaultDriver::OutcomeCode::kSuccess);
+        REQUIRE(Fails::state.reachedPhases().empty());
+        REQUIRE(hasMetrics(opts));
+    }
+
+    SECTION("More workers than actors") {
+        auto [code, opts] = outcome(R"(
+        SchemaVersion: 2018-07-01
+        Actors:
+        - Type: Fails
+          Name: Fails
+          Threads: 2
+          Phases:
+            - Repeat: 1
+              Mode: NoException
+            - Repeat: 1
+              Mode: NoException
+        )",
+                                    0,
+                                    4);
+
+        REQUIRE(code == DefaultDriver::OutcomeCode::kSuccess);
+        REQUIRE(hasMetrics(opts));
+    }
+
+    SECTION("Exception in one worker stops the others") {
+        auto [code, opts] = outcome(R"(
+        SchemaVersion: 2018-07-01
+        Actors:
+        - Type: Fails
+          Name: Fails
+          Threads: 1
+          Phases:
+            - Repeat: 1
+              Mode: BoostException
+        - Type: Fails
+          Name: Fails
+          Threads: 1
+          Phases:
+            - Duration: 1 hour
+              Mode: NoException
+        )",
+                                    0,
+                                    2);
+
+        REQUIRE(code == DefaultDriver::OutcomeCode::kBoostException);
+    }
+
     SECTION("Two Actors simultaneously throw different exceptions") {
         auto [code, opts] = outcome(R"(
         SchemaVersion: 2018-07-01
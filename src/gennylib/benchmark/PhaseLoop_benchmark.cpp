@@ -28,6 +28,7 @@
 #include <gennylib/Orchestrator.hpp>
 #include <gennylib/PhaseLoop.hpp>
 #include <gennylib/context.hpp>
+#include <gennylib/v1/CoarseClock.hpp>
 
 #include <testlib/ActorHelper.hpp>
 #include <testlib/helpers.hpp>
@@ -152,6 +153,53 @@ auto runActors(int threads, long iterations) {
     return actorDur;
 }
 
+// Iterations completed by actors in a Duration-bound phase. Every iteration checks the clock.
+int64_t runDurationActors(int threads, int64_t millis) {
+    IncrementsActor::increments = 0;
+    auto configString = boost::format(R"(
+    SchemaVersion: 2018-07-01
+    Actors:
+    - Type: Increments
+      Name: Increments
+      Threads: %i
+      Phases:
+      - Duration: %i milliseconds
+    )") %
+        threads % millis;
+    auto config = NodeSource(configString.str(), "");
+
+    auto incProducer = std::make_shared<DefaultActorProducer<IncrementsActor>>("Increments");
+
+    ActorHelper ac(config.root(), threads, {{"Increments", incProducer}});
+    ac.run([](const WorkloadContext& wc) { timedRun(wc.actors()); });
+
+    return IncrementsActor::increments;
+}
+
+void compareClockSources(int threads, int64_t millis) {
+    auto iterationsWith = [&](CoarseClock::Mode mode) {
+        CoarseClock::Source source{mode};
+        return runDurationActors(threads, millis);
+    };
+
+    // Interleave so CPU frequency and cache effects don't favor one source.
+    int64_t precise = 0, coarse = 0, ticker = 0;
+    for (int i = 0; i < 3; ++i) {
+        precise += iterationsWith(CoarseClock::Mode::kPrecise);
+        coarse += iterationsWith(CoarseClock::Mode::kKernel);
+        ticker += iterationsWith(CoarseClock::Mode::kTicker);
+    }
+
+    std::cout << "Duration-bound iterations with threads=" << threads << ": precise=" << precise
+              << " coarse=" << coarse << " (" << double(coarse) / double(precise) << "x)"
+              << " ticker=" << ticker << " (" << double(ticker) / double(precise) << "x)"
+              << std::endl;
+
+    REQUIRE(precise > 0);
+    REQUIRE(coarse > 0);
+    REQUIRE(ticker > 0);
+}
+
 void comparePerformance(int threads, long iterations, int tolerance) {
     // just do the stupid simple thing and run it 5 times and take the mean, no need to make it
     // fancy...
@@ -194,3 +242,8 @@ TEST_CASE("PhaseLoop performance", "[benchmark]") {
     // higher tolerance for added latency with more threads
     comparePerformance(500, 10000, 100);
 }
+
+TEST_CASE("PhaseLoop Duration clock sources", "[benchmark]") {
+    compareClockSources(1, 500);
+    compareClockSources(10, 500);
+}
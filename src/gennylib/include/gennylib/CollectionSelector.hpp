@@ -0,0 +1,111 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HEADER_017CE952_6EFC_41EB_B155_153CD2E6026C_INCLUDED
+#define HEADER_017CE952_6EFC_41EB_B155_153CD2E6026C_INCLUDED
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <mongocxx/collection.hpp>
+#include <mongocxx/database.hpp>
+
+#include <gennylib/context.hpp>
+
+#include <value_generators/DefaultRandom.hpp>
+#include <value_generators/v1/SkewedDistributions.hpp>
+
+namespace genny {
+
+/**
+ * Picks one of a fixed set of collections for each operation of actors that spread their load
+ * over many collections, like MultiCollectionQuery.
+ *
+ * The collection handles are built once when the phase is set up, so picking one doesn't
+ * build a name or a handle. Configured by the phase (or its actor):
+ *
+ * ```yaml
+ * CollectionCount: 100
+ * # Optional. %d is replaced by 0, 1, ..., CollectionCount - 1.
+ * CollectionName: Collection%d
+ * # Optional. One of uniform (the default), zipfian or roundRobin.
+ * CollectionSelection: zipfian
+ * # Optional. Only for zipfian: the skew, in (0, 1). Collection 0 is the most popular.
+ * CollectionSkew: 0.99
+ * ```
+ *
+ * Round robin starts from a different collection for each actor so that threads don't all
+ * move through the collections in step.
+ */
+class CollectionSelector {
+public:
+    enum class Selection {
+        kUniform,
+        kZipfian,
+        kRoundRobin,
+    };
+
+    /**
+     * Select from `CollectionCount` collections named after `CollectionName`.
+     *
+     * @throws InvalidConfigurationException if the configuration is invalid.
+     */
+    CollectionSelector(PhaseContext& context, const mongocxx::database& database, ActorId id);
+
+    /**
+     * Select from the given collections, e.g. the ones an actor was given a share of. How to
+     * select is still configured by `context`.
+     */
+    CollectionSelector(PhaseContext& context,
+                       const mongocxx::database& database,
+                       const std::vector<std::string>& names,
+                       ActorId id);
+
+    /**
+     * @return the next collection.
+     */
+    mongocxx::collection& operator()(DefaultRandom& rng) {
+        return _collections[nextIndex(rng)];
+    }
+
+    /**
+     * @return which collection is next, counting from 0.
+     */
+    size_t nextIndex(DefaultRandom& rng);
+
+    size_t size() const {
+        return _collections.size();
+    }
+
+    mongocxx::collection& operator[](size_t index) {
+        return _collections[index];
+    }
+
+    /**
+     * @return `nameTemplate` with `%d` replaced by `index`.
+     */
+    static std::string collectionName(const std::string& nameTemplate, int64_t index);
+
+private:
+    std::vector<mongocxx::collection> _collections;
+    Selection _selection;
+    std::optional<v1::ZipfianDistribution> _zipfian;
+    size_t _nextRoundRobin;
+};
+
+}  // namespace genny
+
+#endif  // HEADER_017CE952_6EFC_41EB_B155_153CD2E6026C_INCLUDED
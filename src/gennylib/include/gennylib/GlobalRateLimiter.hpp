@@ -21,6 +21,7 @@
 #include <thread>
 
 #include <gennylib/conventions.hpp>
+#include <gennylib/v1/ActorScheduler.hpp>
 
 namespace genny {
 
@@ -196,7 +197,7 @@ public:
                 const auto rate = this->getRate() > 1e9 ? 1e9 : this->getRate();
 
                 // Add ±5% jitter to avoid threads waking up at once.
-                std::this_thread::sleep_for(std::chrono::nanoseconds(
+                v1::ActorScheduler::sleep_for(std::chrono::nanoseconds(
                     int64_t(rate * (0.95 + 0.1 * (double(rand()) / RAND_MAX)))));
                 continue;
             }
@@ -16,15 +16,21 @@
 #define HEADER_8615FA7A_9344_43E1_A102_889F47CCC1A6_INCLUDED
 
 #include <atomic>
-#include <condition_variable>
 #include <functional>
 #include <shared_mutex>
+#include <thread>
 #include <vector>
 
+#include <boost/fiber/condition_variable.hpp>
+
 namespace genny {
 
 class Orchestrator;
 
+namespace v1 {
+class WorkerGroup;
+}  // namespace v1
+
 // May eventually want a proper type for Phase, but for now just a typedef is sufficient.
 using PhaseNumber = unsigned int;
 
@@ -41,6 +47,11 @@ public:
     // "Orchestrator Perf" benchmark where as low as 75% of `regIters` occur.
     explicit Orchestrator() {}
 
+    ~Orchestrator();
+
+    Orchestrator(const Orchestrator&) = delete;
+    Orchestrator& operator=(const Orchestrator&) = delete;
+
     /**
      * @return the current phase number
      */
@@ -104,10 +115,35 @@ public:
      */
     bool continueRunning() const;
 
+    /**
+     * Synchronize phases with the Orchestrators of other worker processes.
+     *
+     * Once this process's actors have all started (or ended) a phase, the Orchestrator
+     * arrives at the group's barrier instead of changing phase itself. A background thread
+     * changes the phase locally once every worker has arrived. Aborting any worker aborts
+     * all of them.
+     *
+     * Pre-phase-start hooks run in the last worker to arrive, so they should only touch
+     * state shared by the group, like its rate limiters.
+     *
+     * Must be called before any actor starts.
+     */
+    void joinWorkerGroup(v1::WorkerGroup& group);
+
+    /**
+     * @return the group passed to joinWorkerGroup(), if any.
+     */
+    v1::WorkerGroup* workerGroup() const {
+        return _workerGroup;
+    }
+
 
 private:
     mutable std::shared_mutex _mutex;
-    std::condition_variable_any _phaseChange;
+    // A fiber-aware condition variable so actors running in a v1::ActorScheduler suspend only
+    // their own fiber while waiting on a phase change. It behaves like
+    // std::condition_variable_any for actors that have their own thread.
+    boost::fibers::condition_variable_any _phaseChange;
 
     int _requireTokens = 0;
     int _currentTokens = 0;
@@ -124,6 +160,17 @@ private:
     State state = State::PhaseEnded;
 
     std::vector<OrchestratorCB> _prePhaseHooks;
+
+    // Only set in worker processes. See joinWorkerGroup().
+    v1::WorkerGroup* _workerGroup = nullptr;
+    // Whether this process has arrived at the group barrier for the pending phase change.
+    bool _arrivedInGroup = false;
+    std::atomic_bool _stopWatchingGroup = false;
+    std::thread _groupWatcher;
+
+    void arriveInGroup(bool runHooks);
+    void watchGroup();
+    void abortLocally();
 };
 
 }  // namespace genny
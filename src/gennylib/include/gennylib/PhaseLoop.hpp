@@ -32,7 +32,9 @@
 #include <gennylib/InvalidConfigurationException.hpp>
 #include <gennylib/Orchestrator.hpp>
 #include <gennylib/context.hpp>
-#include <gennylib/v1/Sleeper.hpp>
+#include <gennylib/v1/ActorScheduler.hpp>
+#include <gennylib/v1/CoarseClock.hpp>
+#include <gennylib/v1/Pacer.hpp>
 
 /**
  * @file
@@ -66,9 +68,10 @@ public:
     IterationChecker(std::optional<TimeSpec> minDuration,
                      std::optional<IntegerSpec> minIterations,
                      bool isNop,
-                     TimeSpec sleepBefore,
-                     TimeSpec sleepAfter,
-                     std::optional<RateSpec> rateSpec)
+                     ThinkTimeSpec sleepBefore,
+                     ThinkTimeSpec sleepAfter,
+                     std::optional<RateSpec> rateSpec,
+                     DefaultRandom pacerRng = DefaultRandom{})
         : _minDuration{minDuration},
           // If it is a nop then should iterate 0 times.
           _minIterations{isNop ? IntegerSpec(0l) : minIterations},
@@ -84,23 +87,17 @@ public:
             throw InvalidConfigurationException(str.str());
         }
 
-        if ((sleepBefore || sleepAfter) && rateSpec) {
-            throw InvalidConfigurationException(
-                "GlobalRate must *not* be specified alongside either sleepBefore or sleepAfter. "
-                "genny cannot enforce the global rate when there are mandatory sleeps in"
-                "each thread");
-        }
-
-        _sleeper.emplace(sleepBefore, sleepAfter);
+        _pacer.emplace(sleepBefore, sleepAfter, std::move(pacerRng));
     }
 
     explicit IterationChecker(PhaseContext& phaseContext)
         : IterationChecker(phaseContext["Duration"].maybe<TimeSpec>(),
                            phaseContext["Repeat"].maybe<IntegerSpec>(),
                            phaseContext.isNop(),
-                           phaseContext["SleepBefore"].maybe<TimeSpec>().value_or(TimeSpec{}),
-                           phaseContext["SleepAfter"].maybe<TimeSpec>().value_or(TimeSpec{}),
-                           phaseContext["GlobalRate"].maybe<RateSpec>()) {
+                           phaseContext["SleepBefore"].maybe<ThinkTimeSpec>().value_or(TimeSpec{}),
+                           phaseContext["SleepAfter"].maybe<ThinkTimeSpec>().value_or(TimeSpec{}),
+                           phaseContext["GlobalRate"].maybe<RateSpec>(),
+                           pacerRng(phaseContext)) {
         if (!phaseContext.isNop() && !phaseContext["Duration"] && !phaseContext["Repeat"] &&
             phaseContext["Blocking"].maybe<std::string>() != "None") {
             std::stringstream msg;
@@ -136,6 +133,24 @@ public:
         }
     }
 
+    /**
+     * Wait until the next iteration may start: first for any think time, then for a token from
+     * the GlobalRateLimiter. Think time never runs past the end of the phase's Duration.
+     */
+    void pace(const Orchestrator& o,
+              const PhaseNumber inPhase,
+              const SteadyClock::time_point referenceStartingPoint,
+              const int64_t currentIteration) {
+        if (_pacer->isActive()) {
+            std::optional<SteadyClock::time_point> cutoff;
+            if (_minDuration) {
+                cutoff = referenceStartingPoint + _minDuration->value;
+            }
+            _pacer->awaitNextIteration(o, inPhase, cutoff);
+        }
+        limitRate(referenceStartingPoint, currentIteration, inPhase);
+    }
+
     constexpr void limitRate(const SteadyClock::time_point referenceStartingPoint,
                              const int64_t currentIteration,
                              const PhaseNumber inPhase) {
@@ -155,7 +170,7 @@ public:
                     const auto rate = _rateLimiter->getRate() > 1e9 ? 1e9 : _rateLimiter->getRate();
 
                     // Add ±5% jitter to avoid threads waking up at once.
-                    std::this_thread::sleep_for(std::chrono::nanoseconds(
+                    ActorScheduler::sleep_for(std::chrono::nanoseconds(
                         int64_t(rate * (0.95 + 0.1 * (double(rand()) / RAND_MAX)))));
                     continue;
                 }
@@ -166,7 +181,8 @@ public:
     }
 
     constexpr SteadyClock::time_point computeReferenceStartingPoint() const {
-        // avoid doing now() if no minDuration configured
+        // avoid doing now() if no minDuration configured.
+        // This is read once per phase so use the precise clock: see isDone().
         return _minDuration ? SteadyClock::now() : SteadyClock::time_point::min();
     }
 
@@ -177,6 +193,16 @@ public:
             (!_minDuration || (*_minDuration).value <= now - startedAt);
     }
 
+    /**
+     * Like the above but only reads the clock if a Duration is configured, and then uses
+     * `CoarseClock`. That clock never runs ahead, so a phase never ends early. It may end up to
+     * the clock's resolution late.
+     */
+    constexpr bool isDone(SteadyClock::time_point startedAt, int64_t currentIteration) {
+        return (!_minIterations || currentIteration >= (*_minIterations).value) &&
+            (!_minDuration || (*_minDuration).value <= CoarseClock::now() - startedAt);
+    }
+
     constexpr bool operator==(const IterationChecker& other) const {
         return _minDuration == other._minDuration && _minIterations == other._minIterations;
     }
@@ -185,12 +211,8 @@ public:
         return _doesBlock;
     }
 
-    constexpr void sleepBefore(const Orchestrator& o, const PhaseNumber pn) const {
-        _sleeper->before(o, pn);
-    }
-
-    constexpr void sleepAfter(const Orchestrator& o, const PhaseNumber pn) const {
-        _sleeper->after(o, pn);
+    void iterationDone() {
+        _pacer->iterationDone();
     }
 
 private:
@@ -204,7 +226,20 @@ private:
     // The rate limiter is owned by the workload context.
     GlobalRateLimiter* _rateLimiter = nullptr;
     const bool _doesBlock;  // Computed/cached value. Computed at ctor time.
-    std::optional<v1::Sleeper> _sleeper;
+    std::optional<v1::Pacer> _pacer;
+
+    // Only take a seed from the workload's RandomSeed if think times are random so
+    // existing workloads keep the same random streams.
+    static DefaultRandom pacerRng(PhaseContext& phaseContext) {
+        const auto isRandom = [&](const char* key) {
+            auto spec = phaseContext[key].maybe<ThinkTimeSpec>();
+            return spec && spec->isRandom();
+        };
+        if (isRandom("SleepBefore") || isRandom("SleepAfter")) {
+            return phaseContext.workload().createRNG();
+        }
+        return DefaultRandom{};
+    }
 };
 
 
@@ -248,16 +283,18 @@ public:
 
     constexpr ActorPhaseIterator& operator++() {
         if (_iterationCheck) {
-            _iterationCheck->sleepAfter(*_orchestrator, _inPhase);
+            _iterationCheck->iterationDone();
         }
+        // Iteration boundaries are where actors sharing a worker thread take turns.
+        ActorScheduler::yield();
         ++_currentIteration;
         return *this;
     }
 
     bool operator==(const ActorPhaseIterator& rhs) const {
         if (_iterationCheck) {
-            _iterationCheck->sleepBefore(*_orchestrator, _inPhase);
-            _iterationCheck->limitRate(_referenceStartingPoint, _currentIteration, _inPhase);
+            _iterationCheck->pace(
+                *_orchestrator, _inPhase, _referenceStartingPoint, _currentIteration);
         }
         // clang-format off
         return
@@ -269,7 +306,7 @@ public:
                      // if we block, then check to see if we're done in current phase
                      // else check to see if current phase has expired
                      (_iterationCheck->doesBlockCompletion()
-                            ? _iterationCheck->isDone(_referenceStartingPoint, _currentIteration, SteadyClock::now())
+                            ? _iterationCheck->isDone(_referenceStartingPoint, _currentIteration)
                             : _orchestrator->currentPhase() != _inPhase)))
 
                 // Below checks are mostly for pure correctness;
@@ -18,6 +18,7 @@
 #include <cassert>
 #include <map>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -39,6 +40,7 @@
 #include <gennylib/Node.hpp>
 #include <gennylib/Orchestrator.hpp>
 #include <gennylib/conventions.hpp>
+#include <gennylib/v1/CpuAffinity.hpp>
 #include <gennylib/v1/PoolManager.hpp>
 
 #include <metrics/metrics.hpp>
@@ -168,6 +170,40 @@ public:
      */
     DefaultRandom& getRNGForThread(ActorId id);
 
+    /**
+     * @return a new DefaultRandom seeded from the workload's `RandomSeed`. For setup-time use by
+     * components that need their own random stream rather than an Actor's.
+     */
+    DefaultRandom createRNG();
+
+    /**
+     * @return the workload's `RandomSeed` if it has `RandomSeeding: counter`, otherwise
+     * nullopt. With counter seeding each Actor's DefaultRandom is seeded from its id alone, and
+     * DocumentGenerators seed each document from its iteration rather than from that
+     * DefaultRandom, so values don't depend on the order anything was set up or generated in.
+     */
+    std::optional<uint64_t> counterSeed() const {
+        return _counterSeed;
+    }
+
+    /**
+     * @return the engine picked by `RandomEngine`.
+     */
+    v1::EngineType randomEngine() const {
+        return _rng.engineType();
+    }
+
+    /**
+     * @return the `CpuSet:` configured for the Actor block that produced the actor with the
+     * given `id`, if any. This should only be called by workload drivers.
+     */
+    std::optional<v1::CpuSet> cpuSetFor(ActorId id) const {
+        if (auto it = _actorCpuSets.find(id); it != _actorCpuSets.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
     /**
      * @return if we're done constructing the WorkloadContext.
      * Beyond this point no further accesses should be done to various *Context
@@ -273,6 +309,7 @@ private:
     std::vector<std::unique_ptr<ActorContext>> _actorContexts;
     ActorVector _actors;
     DefaultRandom _rng;
+    std::optional<uint64_t> _counterSeed;
 
     // Indicate that we are doing building the context. This is used to gate certain methods that
     // should not be called after construction.
@@ -287,6 +324,8 @@ private:
 
     std::unordered_map<ActorId, DefaultRandom> _rngRegistry;
 
+    std::unordered_map<ActorId, v1::CpuSet> _actorCpuSets;
+
     std::unordered_map<std::string, std::unique_ptr<GlobalRateLimiter>> _rateLimiters;
 };
 
@@ -328,6 +367,9 @@ public:
     ActorContext(const Node& node, WorkloadContext& workloadContext)
         : v1::HasNode{node}, _workload{&workloadContext}, _phaseContexts{} {
         _phaseContexts = constructPhaseContexts(_node, this);
+        if (auto cpuSet = (*this)["CpuSet"].maybe<std::string>()) {
+            _cpuSet.emplace(*cpuSet);
+        }
     }
 
     // no copy or move
@@ -403,6 +445,36 @@ public:
         return this->workload().getRNGForThread(id);
     }
 
+    /**
+     * @return the cpus this block's actor threads are pinned to, from the `CpuSet:` key.
+     * @see v1::CpuSet for the syntax.
+     */
+    const std::optional<v1::CpuSet>& cpuSet() const {
+        return _cpuSet;
+    }
+
+    /**
+     * @return a new id for one of this block's actors. Actor's constructor calls this, so
+     * actors don't need to.
+     */
+    ActorId nextActorId() {
+        _actorIds.push_back(this->workload().nextActorId());
+        return _actorIds.back();
+    }
+
+    /**
+     * @return which of this block's actors has `id`, counting from 0 in the order they were
+     * constructed, or nullopt if none of them has.
+     */
+    std::optional<size_t> actorIndex(ActorId id) const {
+        for (size_t i = 0; i < _actorIds.size(); ++i) {
+            if (_actorIds[i] == id) {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+
     /**
      * @return a pool from the "default" MongoDB connection-pool.
      * @throws InvalidConfigurationException if no connections available.
@@ -430,6 +502,8 @@ private:
 
     WorkloadContext* _workload;
     std::unordered_map<PhaseNumber, std::unique_ptr<PhaseContext>> _phaseContexts;
+    std::optional<v1::CpuSet> _cpuSet;
+    std::vector<ActorId> _actorIds;
 };
 
 /**
@@ -114,6 +114,56 @@ inline bool operator==(const TimeSpec& lhs, const TimeSpec& rhs) {
 // Use the underlying type in TimeSpec as the default Duration type
 using Duration = typename TimeSpec::ValueT;
 
+/**
+ * How long an actor waits between operations, as configured by `SleepBefore` and `SleepAfter`.
+ * Either a fixed TimeSpec or a distribution that is sampled each iteration.
+ */
+struct ThinkTimeSpec {
+    enum class Distribution {
+        kFixed,
+        kUniform,
+        kExponential,
+    };
+
+    ThinkTimeSpec() = default;
+    ~ThinkTimeSpec() = default;
+
+    // Implicit so a plain TimeSpec continues to mean a fixed think time.
+    ThinkTimeSpec(TimeSpec fixed) : distribution{Distribution::kFixed}, min{fixed}, max{fixed} {}
+
+    static ThinkTimeSpec uniform(TimeSpec min, TimeSpec max) {
+        ThinkTimeSpec out;
+        out.distribution = Distribution::kUniform;
+        out.min = min;
+        out.max = max;
+        return out;
+    }
+
+    static ThinkTimeSpec exponential(TimeSpec mean) {
+        ThinkTimeSpec out;
+        out.distribution = Distribution::kExponential;
+        out.mean = mean;
+        return out;
+    }
+
+    Distribution distribution = Distribution::kFixed;
+    // Fixed uses min == max.
+    TimeSpec min;
+    TimeSpec max;
+    TimeSpec mean;
+
+    /**
+     * @return if this can ever produce a non-zero think time.
+     */
+    explicit operator bool() const {
+        return distribution == Distribution::kExponential ? bool(mean) : bool(max);
+    }
+
+    bool isRandom() const {
+        return distribution != Distribution::kFixed;
+    }
+};
+
 /**
  * BaseRateSpec defined as X operations per Y duration.
  */
@@ -689,6 +739,73 @@ struct convert<genny::TimeSpec> {
     }
 };
 
+/**
+ * Convert between YAML and genny::ThinkTimeSpec
+ *
+ * The YAML syntax accepts a genny::TimeSpec for a fixed think time, or a map:
+ *
+ * ```yaml
+ * SleepAfter: {Distribution: uniform, Min: 50 milliseconds, Max: 150 milliseconds}
+ * SleepAfter: {Distribution: exponential, Mean: 100 milliseconds}
+ * ```
+ */
+template <>
+struct convert<genny::ThinkTimeSpec> {
+    static Node encode(const genny::ThinkTimeSpec& rhs) {
+        using Distribution = genny::ThinkTimeSpec::Distribution;
+        switch (rhs.distribution) {
+            case Distribution::kFixed:
+                return Node{rhs.min};
+            case Distribution::kUniform: {
+                Node out;
+                out["Distribution"] = "uniform";
+                out["Min"] = rhs.min;
+                out["Max"] = rhs.max;
+                return out;
+            }
+            case Distribution::kExponential: {
+                Node out;
+                out["Distribution"] = "exponential";
+                out["Mean"] = rhs.mean;
+                return out;
+            }
+        }
+        throw genny::InvalidConfigurationException("Cannot encode unknown ThinkTimeSpec.");
+    }
+
+    static bool decode(const Node& node, genny::ThinkTimeSpec& rhs) {
+        if (node.IsSequence()) {
+            return false;
+        }
+        if (!node.IsMap()) {
+            rhs = genny::ThinkTimeSpec{node.as<genny::TimeSpec>()};
+            return true;
+        }
+
+        const auto distribution = node["Distribution"].as<std::string>("fixed");
+        if (distribution == "fixed") {
+            rhs = genny::ThinkTimeSpec{node["Value"].as<genny::TimeSpec>()};
+        } else if (distribution == "uniform") {
+            rhs = genny::ThinkTimeSpec::uniform(node["Min"].as<genny::TimeSpec>(),
+                                                node["Max"].as<genny::TimeSpec>());
+            if (rhs.max.value < rhs.min.value) {
+                std::stringstream msg;
+                msg << "Uniform think time needs Min <= Max. Gave Min: " << node["Min"]
+                    << " Max: " << node["Max"];
+                throw genny::InvalidConfigurationException(msg.str());
+            }
+        } else if (distribution == "exponential") {
+            rhs = genny::ThinkTimeSpec::exponential(node["Mean"].as<genny::TimeSpec>());
+        } else {
+            std::stringstream msg;
+            msg << "Unknown think time Distribution '" << distribution
+                << "'. Need one of fixed/uniform/exponential";
+            throw genny::InvalidConfigurationException(msg.str());
+        }
+        return true;
+    }
+};
+
 }  // namespace YAML
 
 
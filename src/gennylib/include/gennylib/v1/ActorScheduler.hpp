@@ -0,0 +1,94 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HEADER_5C1E2B0D_7A43_4F0B_9E5D_2C8F61A4B7E3_INCLUDED
+#define HEADER_5C1E2B0D_7A43_4F0B_9E5D_2C8F61A4B7E3_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace genny::v1 {
+
+/**
+ * Runs many actor instances on a bounded pool of worker threads.
+ *
+ * By default the driver gives every actor its own OS thread. That makes
+ * `Threads: 10000` mean 10,000 threads and stacks. When an `ActorScheduler` is used
+ * instead, each actor runs as a fiber, and a fixed number of OS threads run the fibers.
+ *
+ * Actors never yield explicitly. The PhaseLoop yields at its scheduling points:
+ *
+ * - At every iteration boundary (`ActorPhaseIterator::operator++`).
+ * - While waiting on the `GlobalRateLimiter` or for `SleepBefore`/`SleepAfter`.
+ * - While waiting on the `Orchestrator` for a phase to start or end.
+ *
+ * Calls that block inside the driver (network I/O, waiting for a pool connection)
+ * still block the worker thread that runs the fiber. Size the pool with that in mind.
+ *
+ * Only one `ActorScheduler` may be running at a time in a process.
+ */
+class ActorScheduler {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * Stack size for each actor fiber. This is allocated lazily by the OS, so only the pages
+     * an actor actually touches are committed.
+     */
+    static constexpr std::size_t kDefaultStackSize = 256 * 1024;
+
+    /**
+     * @param workerThreads number of OS threads to run the actor fibers on. Must be positive.
+     * @param stackSize bytes of stack for each fiber.
+     */
+    explicit ActorScheduler(std::size_t workerThreads,
+                            std::size_t stackSize = kDefaultStackSize);
+
+    /**
+     * Run every task to completion as a fiber on the worker pool.
+     * Blocks the calling thread, which does not run any tasks itself.
+     */
+    void run(std::vector<Task> tasks);
+
+    /**
+     * @return whether the calling thread is an `ActorScheduler` worker thread.
+     */
+    static bool isCooperative();
+
+    /**
+     * Let another actor run on this worker thread. This is a no-op outside of an `ActorScheduler`.
+     */
+    static void yield();
+
+    /**
+     * Sleep without holding the worker thread when running in an `ActorScheduler`, or
+     * `std::this_thread::sleep_for` otherwise.
+     */
+    template <typename Rep, typename Period>
+    static void sleep_for(const std::chrono::duration<Rep, Period>& duration) {
+        sleepNanos(std::chrono::duration_cast<std::chrono::nanoseconds>(duration));
+    }
+
+private:
+    static void sleepNanos(std::chrono::nanoseconds duration);
+
+    const std::size_t _workerThreads;
+    const std::size_t _stackSize;
+};
+
+}  // namespace genny::v1
+
+#endif  // HEADER_5C1E2B0D_7A43_4F0B_9E5D_2C8F61A4B7E3_INCLUDED
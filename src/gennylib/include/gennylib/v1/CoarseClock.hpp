@@ -0,0 +1,123 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HEADER_D6E0A4C2_1F3B_4E8A_B5C9_7A20E3F1D894_INCLUDED
+#define HEADER_D6E0A4C2_1F3B_4E8A_B5C9_7A20E3F1D894_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+#ifdef __linux__
+#include <time.h>
+#endif
+
+namespace genny::v1 {
+
+/**
+ * A steady clock for checks that can tolerate being a little late, such as whether a Phase's
+ * `Duration` has elapsed. It has the same epoch as `std::chrono::steady_clock`, and its
+ * time_points can be compared with that clock's.
+ *
+ * It never runs ahead of `steady_clock`. Depending on the `Mode` it lags by up to:
+ *
+ * - `kPrecise`: nothing. This reads `steady_clock` and is the default.
+ * - `kKernel`: one kernel tick, typically 1-4ms. This reads `CLOCK_MONOTONIC_COARSE`, which
+ *   skips the vDSO's hardware counter read. Behaves like `kPrecise` on platforms without it.
+ * - `kTicker`: the configured resolution. A single background thread stores `steady_clock`
+ *   into a cache-line-isolated atomic, and every reader does a relaxed load of it.
+ */
+class CoarseClock {
+public:
+    using duration = std::chrono::steady_clock::duration;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::steady_clock::time_point;
+    static constexpr bool is_steady = true;
+
+    static_assert(std::is_same_v<duration, std::chrono::nanoseconds>,
+                  "Clock representation must be nano seconds");
+
+    enum class Mode { kPrecise, kKernel, kTicker };
+
+    static time_point now() noexcept {
+        switch (_state.mode.load(std::memory_order_acquire)) {
+            case Mode::kTicker:
+                return time_point{duration{_state.ticked.load(std::memory_order_relaxed)}};
+            case Mode::kKernel:
+                return kernelNow();
+            case Mode::kPrecise:
+                break;
+        }
+        return std::chrono::steady_clock::now();
+    }
+
+    static Mode mode() noexcept {
+        return _state.mode.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Selects the time source used by `CoarseClock::now()` for the lifetime of this object.
+     * Starts the ticker thread for `Mode::kTicker`. Only one may exist at a time.
+     */
+    class Source {
+    public:
+        explicit Source(Mode mode,
+                        std::chrono::nanoseconds tickerResolution = std::chrono::microseconds{100});
+
+        ~Source();
+
+        Source(const Source&) = delete;
+        Source& operator=(const Source&) = delete;
+        Source(Source&&) = delete;
+        Source& operator=(Source&&) = delete;
+
+    private:
+        std::atomic_bool _stop = false;
+        std::thread _ticker;
+    };
+
+private:
+    static time_point kernelNow() noexcept {
+#ifdef __linux__
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+        return time_point{std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec}};
+#else
+        return std::chrono::steady_clock::now();
+#endif
+    }
+
+    // Same as GlobalRateLimiter::CacheLineSize.
+    static constexpr int CacheLineSize = 64;
+
+    // Readers on every actor thread load both fields, so keep them together and away from
+    // anything else that is written to.
+    struct alignas(CacheLineSize) State {
+        std::atomic<Mode> mode{Mode::kPrecise};
+        std::atomic<int64_t> ticked{0};
+        // Whether a Source exists. Only Sources read or write it.
+        std::atomic_bool hasSource{false};
+    };
+
+    static State _state;
+};
+
+inline CoarseClock::State CoarseClock::_state{};
+
+}  // namespace genny::v1
+
+#endif  // HEADER_D6E0A4C2_1F3B_4E8A_B5C9_7A20E3F1D894_INCLUDED
@@ -0,0 +1,80 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HEADER_9B3F0C6E_58D2_4A1E_8C47_E16D2A0F93B5_INCLUDED
+#define HEADER_9B3F0C6E_58D2_4A1E_8C47_E16D2A0F93B5_INCLUDED
+
+#include <set>
+#include <string>
+#include <utility>
+
+namespace genny::v1 {
+
+/**
+ * A set of logical CPUs that a thread may run on.
+ *
+ * Parsed from the same list syntax as `taskset -c` and `/sys/devices/system/cpu/online`,
+ * plus NUMA nodes by name:
+ *
+ * ```yaml
+ * CpuSet: 0-3,8,10-11   # cpus 0,1,2,3,8,10,11
+ * CpuSet: node1         # every cpu on NUMA node 1
+ * CpuSet: node0,16-17   # may be mixed
+ * ```
+ *
+ * NUMA nodes are resolved using `/sys/devices/system/node/node<N>/cpulist`.
+ */
+class CpuSet {
+public:
+    /**
+     * @throws InvalidConfigurationException if `spec` isn't valid or names an unknown NUMA node.
+     */
+    explicit CpuSet(const std::string& spec);
+
+    /**
+     * @return the set the calling thread is currently allowed to run on.
+     */
+    static CpuSet ofCurrentThread();
+
+    const std::set<int>& cpus() const {
+        return _cpus;
+    }
+
+    /**
+     * @return the canonical list syntax, e.g. `0-3,8`.
+     */
+    std::string toString() const;
+
+    /**
+     * Restrict the calling thread to this set. Threads it creates afterwards inherit the set.
+     *
+     * This does nothing but log a warning on platforms without thread affinity (macOS).
+     *
+     * @throws std::system_error if the OS rejects the set, e.g. because a cpu is offline.
+     */
+    void pinCurrentThread() const;
+
+    bool operator==(const CpuSet& other) const {
+        return _cpus == other._cpus;
+    }
+
+private:
+    explicit CpuSet(std::set<int> cpus) : _cpus{std::move(cpus)} {}
+
+    std::set<int> _cpus;
+};
+
+}  // namespace genny::v1
+
+#endif  // HEADER_9B3F0C6E_58D2_4A1E_8C47_E16D2A0F93B5_INCLUDED
@@ -0,0 +1,135 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HEADER_3E7B91A4_C2D8_4F56_A0E3_8B14D6C7F259_INCLUDED
+#define HEADER_3E7B91A4_C2D8_4F56_A0E3_8B14D6C7F259_INCLUDED
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+#include <boost/random/exponential_distribution.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+#include <gennylib/Orchestrator.hpp>
+#include <gennylib/conventions.hpp>
+#include <gennylib/v1/ActorScheduler.hpp>
+
+#include <value_generators/DefaultRandom.hpp>
+
+namespace genny::v1 {
+
+/**
+ * Computes when an actor thread may start its next iteration from its `SleepBefore` and
+ * `SleepAfter` think times, then sleeps until that absolute deadline.
+ *
+ * Think time after an iteration is measured from the end of that iteration. Think time before
+ * an iteration is added on top, so fixed values behave like back-to-back `sleep_for` calls.
+ * Because the deadline is absolute, any time spent between iterations (e.g. in the PhaseLoop
+ * itself) counts towards the think time instead of being added to it.
+ *
+ * Any `GlobalRate` is applied by the caller after the deadline passes. The think time is a
+ * lower bound on each thread's pacing and the rate limiter is an upper bound on the
+ * aggregate, so both hold together.
+ */
+class Pacer {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @param rng used to sample random think times. Only used if either spec is random.
+     */
+    Pacer(ThinkTimeSpec before, ThinkTimeSpec after, DefaultRandom rng = DefaultRandom{})
+        : _before{before}, _after{after}, _rng{std::move(rng)} {}
+
+    // No copies or moves; the PhaseLoop iterators keep pointers to the owning IterationChecker.
+    Pacer(const Pacer& other) = delete;
+    Pacer& operator=(const Pacer& other) = delete;
+
+    Pacer(Pacer&& other) = delete;
+    Pacer& operator=(Pacer&& other) = delete;
+
+    /**
+     * @return if this pacer ever waits.
+     */
+    bool isActive() const {
+        return bool(_before) || bool(_after);
+    }
+
+    /**
+     * Record that an iteration just finished.
+     */
+    void iterationDone() {
+        if (_after) {
+            _notBefore = clock::now() + sample(_after);
+        }
+    }
+
+    /**
+     * Sleep until the next iteration may start.
+     *
+     * @param cutoff stop waiting at this time, e.g. when the phase's Duration expires.
+     * Ignored if not set.
+     */
+    void awaitNextIteration(const Orchestrator& o,
+                            PhaseNumber pn,
+                            std::optional<clock::time_point> cutoff = std::nullopt) {
+        if (!isActive()) {
+            return;
+        }
+        auto deadline = std::max(_notBefore.value_or(clock::now()), clock::now());
+        _notBefore.reset();
+        if (_before) {
+            deadline += sample(_before);
+        }
+        if (cutoff) {
+            deadline = std::min(deadline, *cutoff);
+        }
+
+        // Sleep in slices of at most 1 second so we notice the phase ending under us.
+        // Otherwise long think times can cause the workloads to run visibly longer than
+        // the phase.
+        constexpr auto maxSlice = std::chrono::seconds{1};
+        for (auto now = clock::now(); now < deadline && o.currentPhase() == pn;
+             now = clock::now()) {
+            ActorScheduler::sleep_for(std::min<clock::duration>(deadline - now, maxSlice));
+        }
+    }
+
+private:
+    Duration sample(const ThinkTimeSpec& spec) {
+        using Distribution = ThinkTimeSpec::Distribution;
+        switch (spec.distribution) {
+            case Distribution::kFixed:
+                return spec.min.value;
+            case Distribution::kUniform:
+                return Duration{boost::random::uniform_int_distribution<Duration::rep>{
+                    spec.min.count(), spec.max.count()}(_rng)};
+            case Distribution::kExponential:
+                return Duration{Duration::rep(
+                    boost::random::exponential_distribution<double>{1.0 / spec.mean.count()}(
+                        _rng))};
+        }
+        return Duration::zero();
+    }
+
+    const ThinkTimeSpec _before;
+    const ThinkTimeSpec _after;
+    DefaultRandom _rng;
+    std::optional<clock::time_point> _notBefore;
+};
+
+}  // namespace genny::v1
+
+#endif  // HEADER_3E7B91A4_C2D8_4F56_A0E3_8B14D6C7F259_INCLUDED
@@ -18,6 +18,7 @@
 #include <chrono>
 
 #include <gennylib/conventions.hpp>
+#include <gennylib/v1/ActorScheduler.hpp>
 
 
 namespace genny::v1 {
@@ -55,7 +56,7 @@ public:
      */
     constexpr void before(const Orchestrator& o, const PhaseNumber pn) const {
         if (_before.count() && o.currentPhase() == pn) {
-            std::this_thread::sleep_for(_before);
+            ActorScheduler::sleep_for(_before);
         }
     }
 
@@ -64,7 +65,7 @@ public:
      */
     constexpr void after(const Orchestrator& o, const PhaseNumber pn) const {
         if (_after.count() && o.currentPhase() == pn) {
-            std::this_thread::sleep_for(_after);
+            ActorScheduler::sleep_for(_after);
         }
     }
 
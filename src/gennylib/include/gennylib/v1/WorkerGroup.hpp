@@ -0,0 +1,140 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HEADER_5C2A8E71_94D3_4B0F_A6E8_3F17C0B2D946_INCLUDED
+#define HEADER_5C2A8E71_94D3_4B0F_A6E8_3F17C0B2D946_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <gennylib/GlobalRateLimiter.hpp>
+#include <gennylib/conventions.hpp>
+
+namespace genny::v1 {
+
+/**
+ * State shared between the worker processes of `genny run --workers N`.
+ *
+ * The group is created by the coordinating process *before* it forks the workers. It lives in
+ * an anonymous shared mapping, so every worker sees the same memory and nothing needs to be
+ * cleaned up from `/dev/shm` if a worker crashes.
+ *
+ * It holds:
+ *
+ * - A phase barrier. Each worker's Orchestrator arrives once its own actors are ready to
+ *   start or end a phase, and all workers move on together. See Orchestrator::joinWorkerGroup.
+ * - The GlobalRateLimiters, so a `GlobalRate` caps all workers together rather than each one.
+ * - Named counters, for value generators that hand out values across all actors, like a
+ *   sequential `^FromFile`, so workers don't each hand out the same ones.
+ *
+ * Every worker constructs the same actors from the same workload, so they all ask for the same
+ * rate limiters and arrive at the barrier the same number of times.
+ *
+ * A worker that dies while holding the group's lock aborts the group (on Linux, where the lock
+ * is a robust mutex). The coordinator also aborts it when any worker exits unsuccessfully.
+ */
+class WorkerGroup {
+public:
+    // Each distinct RateLimiterName in a workload takes one slot.
+    static constexpr size_t kMaxRateLimiters = 64;
+    // Each distinct counter name takes one slot.
+    static constexpr size_t kMaxCounters = 64;
+
+    /**
+     * @param workers number of processes that will join the group. Must be at least 1.
+     */
+    explicit WorkerGroup(size_t workers);
+
+    ~WorkerGroup();
+
+    WorkerGroup(const WorkerGroup&) = delete;
+    WorkerGroup& operator=(const WorkerGroup&) = delete;
+    WorkerGroup(WorkerGroup&&) = delete;
+    WorkerGroup& operator=(WorkerGroup&&) = delete;
+
+    /**
+     * Called in a forked worker to record which worker it is.
+     */
+    void joinAs(size_t index);
+
+    size_t size() const {
+        return _size;
+    }
+
+    /**
+     * @return this process's worker index, in `[0, size())`. The coordinator is 0 too.
+     */
+    size_t index() const {
+        return _index;
+    }
+
+    /**
+     * Record that this worker is ready for the next phase transition. Does not block.
+     *
+     * @param onLast called by whichever worker arrives last, before any worker is released.
+     * Every worker passes an equivalent callback, so it doesn't matter which one runs.
+     */
+    void arrive(const std::function<void()>& onLast);
+
+    /**
+     * Block until all workers have arrived since `seen`, the group is aborted, or `stop` is set.
+     * Setting `stop` must be followed by wakeAll().
+     *
+     * @return the number of completed transitions.
+     */
+    uint64_t awaitTransition(uint64_t seen, const std::atomic_bool& stop);
+
+    /**
+     * Wake every worker blocked in awaitTransition() so it can recheck its `stop` flag.
+     */
+    void wakeAll();
+
+    /**
+     * Stop every worker's workload. Idempotent.
+     */
+    void abort();
+
+    bool aborted() const;
+
+    /**
+     * Get or create the rate limiter shared by all workers under this name.
+     *
+     * @throws InvalidConfigurationException if the workload uses more than kMaxRateLimiters names.
+     */
+    GlobalRateLimiter* rateLimiter(const std::string& name, const RateSpec& spec);
+
+    /**
+     * Get or create the counter shared by all workers under this name. It starts at 0.
+     *
+     * @throws InvalidConfigurationException if the workload uses more than kMaxCounters names.
+     */
+    std::atomic_int64_t& counter(const std::string& name);
+
+private:
+    struct State;
+    class Lock;
+
+    boost::interprocess::mapped_region _region;
+    State* _state;
+    size_t _size;
+    size_t _index = 0;
+};
+
+}  // namespace genny::v1
+
+#endif  // HEADER_5C2A8E71_94D3_4B0F_A6E8_3F17C0B2D946_INCLUDED
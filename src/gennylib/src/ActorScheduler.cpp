@@ -0,0 +1,193 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gennylib/v1/ActorScheduler.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include <boost/fiber/algo/algorithm.hpp>
+#include <boost/fiber/all.hpp>
+#include <boost/throw_exception.hpp>
+
+namespace genny::v1 {
+namespace {
+
+thread_local bool cooperative = false;
+
+/**
+ * Ready queue shared by all worker threads of one ActorScheduler.
+ */
+struct SharedReadyQueue {
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::deque<boost::fibers::context*> ready;
+};
+
+/**
+ * Fiber scheduling algorithm modeled on boost::fibers::algo::shared_work.
+ *
+ * Differences:
+ *
+ * 1. The queue belongs to a scheduler instance rather than being process-global.
+ * 2. Idle workers sleep on the queue's condition variable. Making a fiber ready on one
+ *    worker wakes an idle worker to run it, rather than it waiting for the current fiber
+ *    on this worker to yield.
+ */
+class SharedQueueAlgorithm final : public boost::fibers::algo::algorithm {
+public:
+    explicit SharedQueueAlgorithm(SharedReadyQueue& shared) : _shared{shared} {}
+
+    void awakened(boost::fibers::context* ctx) noexcept override {
+        // Main and dispatcher contexts can't migrate between threads.
+        if (ctx->is_context(boost::fibers::type::pinned_context)) {
+            _pinned.push_back(*ctx);
+            return;
+        }
+        ctx->detach();
+        {
+            std::lock_guard<std::mutex> lk{_shared.mutex};
+            _shared.ready.push_back(ctx);
+        }
+        _shared.wakeup.notify_one();
+    }
+
+    boost::fibers::context* pick_next() noexcept override {
+        boost::fibers::context* ctx = nullptr;
+        {
+            std::lock_guard<std::mutex> lk{_shared.mutex};
+            if (!_shared.ready.empty()) {
+                ctx = _shared.ready.front();
+                _shared.ready.pop_front();
+            }
+        }
+        if (ctx) {
+            boost::fibers::context::active()->attach(ctx);
+        } else if (!_pinned.empty()) {
+            ctx = &_pinned.front();
+            _pinned.pop_front();
+        }
+        return ctx;
+    }
+
+    bool has_ready_fibers() const noexcept override {
+        std::lock_guard<std::mutex> lk{_shared.mutex};
+        return !_shared.ready.empty() || !_pinned.empty();
+    }
+
+    void suspend_until(const std::chrono::steady_clock::time_point& until) noexcept override {
+        std::unique_lock<std::mutex> lk{_shared.mutex};
+        const auto wake = [&]() { return _notified || !_shared.ready.empty(); };
+        if (until == (std::chrono::steady_clock::time_point::max)()) {
+            _shared.wakeup.wait(lk, wake);
+        } else {
+            _shared.wakeup.wait_until(lk, until, wake);
+        }
+        _notified = false;
+    }
+
+    void notify() noexcept override {
+        {
+            std::lock_guard<std::mutex> lk{_shared.mutex};
+            _notified = true;
+        }
+        // The condition variable is shared, so we can't target only this worker.
+        _shared.wakeup.notify_all();
+    }
+
+private:
+    SharedReadyQueue& _shared;
+    boost::fibers::scheduler::ready_queue_type _pinned;
+    // Guarded by _shared.mutex.
+    bool _notified = false;
+};
+
+}  // namespace
+
+
+ActorScheduler::ActorScheduler(std::size_t workerThreads, std::size_t stackSize)
+    : _workerThreads{workerThreads}, _stackSize{stackSize} {
+    if (_workerThreads == 0) {
+        BOOST_THROW_EXCEPTION(
+            std::invalid_argument("ActorScheduler needs at least one worker thread"));
+    }
+}
+
+void ActorScheduler::run(std::vector<Task> tasks) {
+    SharedReadyQueue shared;
+
+    boost::fibers::mutex mutex;
+    boost::fibers::condition_variable allDone;
+    std::size_t remaining = tasks.size();
+
+    auto worker = [&](bool launchesTasks) {
+        boost::fibers::use_scheduling_algorithm<SharedQueueAlgorithm>(shared);
+        cooperative = true;
+
+        if (launchesTasks) {
+            for (auto& task : tasks) {
+                boost::fibers::fiber{std::allocator_arg,
+                                     boost::fibers::fixedsize_stack{_stackSize},
+                                     [&, task = std::move(task)]() {
+                                         task();
+                                         std::unique_lock<boost::fibers::mutex> lk{mutex};
+                                         if (--remaining == 0) {
+                                             allDone.notify_all();
+                                         }
+                                     }}
+                    .detach();
+            }
+        }
+
+        // Blocking the worker's main fiber lets the scheduler run actor fibers until all finish.
+        {
+            std::unique_lock<boost::fibers::mutex> lk{mutex};
+            allDone.wait(lk, [&]() { return remaining == 0; });
+        }
+        cooperative = false;
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(_workerThreads);
+    for (std::size_t i = 0; i < _workerThreads; ++i) {
+        workers.emplace_back(worker, i == 0);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+}
+
+bool ActorScheduler::isCooperative() {
+    return cooperative;
+}
+
+void ActorScheduler::yield() {
+    if (cooperative) {
+        boost::this_fiber::yield();
+    }
+}
+
+void ActorScheduler::sleepNanos(std::chrono::nanoseconds duration) {
+    if (cooperative) {
+        boost::this_fiber::sleep_for(duration);
+    } else {
+        std::this_thread::sleep_for(duration);
+    }
+}
+
+}  // namespace genny::v1
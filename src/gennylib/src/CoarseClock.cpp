@@ -0,0 +1,62 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gennylib/v1/CoarseClock.hpp>
+
+#include <stdexcept>
+
+#include <boost/throw_exception.hpp>
+
+namespace genny::v1 {
+
+CoarseClock::Source::Source(Mode mode, std::chrono::nanoseconds tickerResolution) {
+    if (mode == Mode::kTicker && tickerResolution.count() <= 0) {
+        BOOST_THROW_EXCEPTION(std::invalid_argument("Ticker resolution must be positive"));
+    }
+    // Checked for every mode: a kPrecise Source destroyed after another Source was created would
+    // otherwise reset the mode out from under it.
+    if (_state.hasSource.exchange(true, std::memory_order_acq_rel)) {
+        BOOST_THROW_EXCEPTION(std::logic_error("Only one CoarseClock::Source may exist at a time"));
+    }
+    if (mode == Mode::kTicker) {
+        // Publish a value before any reader can see kTicker.
+        _state.ticked.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                            std::memory_order_relaxed);
+        try {
+            _ticker = std::thread{[this, tickerResolution]() {
+                while (!_stop.load(std::memory_order_relaxed)) {
+                    std::this_thread::sleep_for(tickerResolution);
+                    _state.ticked.store(
+                        std::chrono::steady_clock::now().time_since_epoch().count(),
+                        std::memory_order_relaxed);
+                }
+            }};
+        } catch (...) {
+            _state.hasSource.store(false, std::memory_order_release);
+            throw;
+        }
+    }
+    _state.mode.store(mode, std::memory_order_release);
+}
+
+CoarseClock::Source::~Source() {
+    _state.mode.store(Mode::kPrecise, std::memory_order_release);
+    if (_ticker.joinable()) {
+        _stop = true;
+        _ticker.join();
+    }
+    _state.hasSource.store(false, std::memory_order_release);
+}
+
+}  // namespace genny::v1
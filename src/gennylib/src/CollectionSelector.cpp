@@ -0,0 +1,110 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gennylib/CollectionSelector.hpp>
+
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <gennylib/InvalidConfigurationException.hpp>
+#include <gennylib/conventions.hpp>
+
+namespace genny {
+namespace {
+
+CollectionSelector::Selection parseSelection(const std::string& selection) {
+    if (selection == "uniform") {
+        return CollectionSelector::Selection::kUniform;
+    } else if (selection == "zipfian") {
+        return CollectionSelector::Selection::kZipfian;
+    } else if (selection == "roundRobin") {
+        return CollectionSelector::Selection::kRoundRobin;
+    }
+    BOOST_THROW_EXCEPTION(InvalidConfigurationException(
+        "Unknown CollectionSelection '" + selection + "'. Need one of uniform/zipfian/roundRobin"));
+}
+
+std::vector<std::string> configuredNames(PhaseContext& context) {
+    const auto count = context["CollectionCount"].to<IntegerSpec>().value;
+    const auto nameTemplate =
+        context["CollectionName"].maybe<std::string>().value_or("Collection%d");
+    if (count > 1 && nameTemplate.find("%d") == std::string::npos) {
+        BOOST_THROW_EXCEPTION(InvalidConfigurationException(
+            "CollectionName '" + nameTemplate + "' needs a %d to name more than one collection"));
+    }
+    std::vector<std::string> names;
+    for (int64_t i = 0; i < count; ++i) {
+        names.push_back(CollectionSelector::collectionName(nameTemplate, i));
+    }
+    return names;
+}
+
+}  // namespace
+
+CollectionSelector::CollectionSelector(PhaseContext& context,
+                                       const mongocxx::database& database,
+                                       ActorId id)
+    : CollectionSelector(context, database, configuredNames(context), id) {}
+
+CollectionSelector::CollectionSelector(PhaseContext& context,
+                                       const mongocxx::database& database,
+                                       const std::vector<std::string>& names,
+                                       ActorId id)
+    : _selection{parseSelection(
+          context["CollectionSelection"].maybe<std::string>().value_or("uniform"))},
+      _nextRoundRobin{names.empty() ? 0 : id % names.size()} {
+    if (names.empty()) {
+        BOOST_THROW_EXCEPTION(
+            InvalidConfigurationException("Need at least one collection to select from"));
+    }
+    _collections.reserve(names.size());
+    for (auto&& name : names) {
+        _collections.push_back(database[name]);
+    }
+    if (_selection == Selection::kZipfian) {
+        const auto skew = context["CollectionSkew"].maybe<double>().value_or(0.99);
+        if (!(skew > 0 && skew < 1)) {
+            BOOST_THROW_EXCEPTION(
+                InvalidConfigurationException("CollectionSkew must be between 0 and 1"));
+        }
+        _zipfian.emplace(_collections.size(), skew);
+    }
+}
+
+size_t CollectionSelector::nextIndex(DefaultRandom& rng) {
+    switch (_selection) {
+        case Selection::kUniform:
+            return boost::random::uniform_int_distribution<size_t>{0, _collections.size() - 1}(
+                rng);
+        case Selection::kZipfian:
+            return (*_zipfian)(rng);
+        case Selection::kRoundRobin: {
+            const auto index = _nextRoundRobin;
+            _nextRoundRobin = index + 1 == _collections.size() ? 0 : index + 1;
+            return index;
+        }
+    }
+    return 0;
+}
+
+std::string CollectionSelector::collectionName(const std::string& nameTemplate, int64_t index) {
+    auto name = nameTemplate;
+    const auto at = name.find("%d");
+    if (at != std::string::npos) {
+        name.replace(at, 2, std::to_string(index));
+    }
+    return name;
+}
+
+}  // namespace genny
@@ -0,0 +1,190 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gennylib/v1/CpuAffinity.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <boost/log/trivial.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <gennylib/InvalidConfigurationException.hpp>
+
+namespace genny::v1 {
+namespace {
+
+[[noreturn]] void throwInvalid(const std::string& spec, const std::string& why) {
+    std::ostringstream msg;
+    msg << "Invalid CpuSet '" << spec << "': " << why;
+    BOOST_THROW_EXCEPTION(InvalidConfigurationException(msg.str()));
+}
+
+bool allDigits(const std::string& str) {
+    return !str.empty() &&
+        std::all_of(str.begin(), str.end(), [](unsigned char c) { return std::isdigit(c); });
+}
+
+int parseCpu(const std::string& spec, const std::string& token) {
+    if (!allDigits(token)) {
+        throwInvalid(spec, "expected a cpu number but got '" + token + "'");
+    }
+    try {
+        return std::stoi(token);
+    } catch (const std::out_of_range&) {
+        throwInvalid(spec, "cpu number '" + token + "' is too large");
+    } catch (const std::invalid_argument&) {
+        throwInvalid(spec, "expected a cpu number but got '" + token + "'");
+    }
+}
+
+std::string trim(const std::string& str) {
+    const auto begin = str.find_first_not_of(" \t\n");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    const auto end = str.find_last_not_of(" \t\n");
+    return str.substr(begin, end - begin + 1);
+}
+
+std::string numaNodeCpuList(const std::string& spec, const std::string& node) {
+    // The node name becomes part of a path, so only accept node<digits>.
+    if (!allDigits(node.substr(4))) {
+        throwInvalid(spec, "expected a NUMA node like 'node0' but got '" + node + "'");
+    }
+    const auto path = "/sys/devices/system/node/" + node + "/cpulist";
+    std::ifstream in{path};
+    std::string list;
+    if (!in || !std::getline(in, list)) {
+        throwInvalid(spec, "unknown NUMA node '" + node + "' (could not read " + path + ")");
+    }
+    return list;
+}
+
+void addList(const std::string& spec, const std::string& list, std::set<int>& out) {
+    std::istringstream tokens{list};
+    std::string token;
+    while (std::getline(tokens, token, ',')) {
+        token = trim(token);
+        if (token.rfind("node", 0) == 0) {
+            // Node cpulists never name other nodes, so this recurses at most once.
+            addList(spec, numaNodeCpuList(spec, token), out);
+            continue;
+        }
+        if (const auto dash = token.find('-'); dash != std::string::npos) {
+            const auto first = parseCpu(spec, token.substr(0, dash));
+            const auto last = parseCpu(spec, token.substr(dash + 1));
+            if (last < first) {
+                throwInvalid(spec, "range '" + token + "' is backwards");
+            }
+#ifdef __linux__
+            // Checked here too so that a huge range fails before filling the set.
+            if (last >= CPU_SETSIZE) {
+                throwInvalid(spec, "cpus must be less than " + std::to_string(CPU_SETSIZE));
+            }
+#endif
+            for (int cpu = first; cpu <= last; ++cpu) {
+                out.insert(cpu);
+            }
+        } else {
+            out.insert(parseCpu(spec, token));
+        }
+    }
+}
+
+}  // namespace
+
+
+CpuSet::CpuSet(const std::string& spec) {
+    addList(spec, spec, _cpus);
+    if (_cpus.empty()) {
+        throwInvalid(spec, "no cpus given");
+    }
+#ifdef __linux__
+    if (*_cpus.rbegin() >= CPU_SETSIZE) {
+        throwInvalid(spec, "cpus must be less than " + std::to_string(CPU_SETSIZE));
+    }
+#endif
+}
+
+CpuSet CpuSet::ofCurrentThread() {
+    std::set<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (const int err = pthread_getaffinity_np(pthread_self(), sizeof(set), &set); err != 0) {
+        BOOST_THROW_EXCEPTION(
+            std::system_error(err, std::generic_category(), "Could not get thread affinity"));
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) {
+            cpus.insert(cpu);
+        }
+    }
+#else
+    for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu) {
+        cpus.insert(int(cpu));
+    }
+#endif
+    return CpuSet{std::move(cpus)};
+}
+
+std::string CpuSet::toString() const {
+    std::ostringstream out;
+    for (auto it = _cpus.begin(); it != _cpus.end();) {
+        const int first = *it;
+        int last = first;
+        while (++it != _cpus.end() && *it == last + 1) {
+            ++last;
+        }
+        if (first != *_cpus.begin()) {
+            out << ',';
+        }
+        out << first;
+        if (last != first) {
+            out << '-' << last;
+        }
+    }
+    return out.str();
+}
+
+void CpuSet::pinCurrentThread() const {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const int cpu : _cpus) {
+        CPU_SET(cpu, &set);
+    }
+    if (const int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set); err != 0) {
+        BOOST_THROW_EXCEPTION(std::system_error(
+            err, std::generic_category(), "Could not pin thread to cpus " + toString()));
+    }
+#else
+    BOOST_LOG_TRIVIAL(warning) << "Thread affinity is not supported on this platform. Ignoring "
+                                  "CpuSet "
+                               << toString();
+#endif
+}
+
+}  // namespace genny::v1
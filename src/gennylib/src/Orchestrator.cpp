@@ -16,6 +16,8 @@
 
 #include <boost/log/trivial.hpp>
 
+#include <gennylib/v1/WorkerGroup.hpp>
+
 #include <algorithm>  // std::max
 #include <cassert>
 
@@ -42,6 +44,14 @@ using reader = std::shared_lock<std::shared_mutex>;
 /** @private */
 using writer = std::unique_lock<std::shared_mutex>;
 
+Orchestrator::~Orchestrator() {
+    if (_groupWatcher.joinable()) {
+        _stopWatchingGroup = true;
+        _workerGroup->wakeAll();
+        _groupWatcher.join();
+    }
+}
+
 PhaseNumber Orchestrator::currentPhase() const {
     reader lock{_mutex};
 
@@ -81,7 +91,7 @@ PhaseNumber Orchestrator::awaitPhaseStart(bool block, int addTokens) {
     _currentTokens += addTokens;
 
     const auto currentPhase = this->_current;
-    if (_currentTokens >= _requireTokens) {
+    if (_currentTokens >= _requireTokens && !_workerGroup) {
         for (auto&& cb : _prePhaseHooks) {
             cb(this);
         }
@@ -89,6 +99,10 @@ PhaseNumber Orchestrator::awaitPhaseStart(bool block, int addTokens) {
         _phaseChange.notify_all();
         state = State::PhaseStarted;
     } else {
+        if (_currentTokens >= _requireTokens) {
+            // watchGroup() starts the phase once the other workers are ready too.
+            arriveInGroup(true);
+        }
         if (block) {
             while (state != State::PhaseStarted && !this->_errors) {
                 _phaseChange.wait(lock);
@@ -134,12 +148,15 @@ bool Orchestrator::awaitPhaseEnd(bool block, int removeTokens) {
     // Similar thing applies to the block in awaitPhaseStart() where we
     // compare with >= rather than ==.
 
-    if (_currentTokens <= 0) {
+    if (_currentTokens <= 0 && !_workerGroup) {
         ++_current;
         BOOST_LOG_TRIVIAL(debug) << "Ended phase " << (this->_current - 1);
         _phaseChange.notify_all();
         state = State::PhaseEnded;
     } else {
+        if (_currentTokens <= 0) {
+            arriveInGroup(false);
+        }
         if (block) {
             while (state != State::PhaseEnded && !this->_errors) {
                 _phaseChange.wait(lock);
@@ -155,9 +172,69 @@ void Orchestrator::addPrePhaseStartHook(const OrchestratorCB& f) {
 }
 
 void Orchestrator::abort() {
+    abortLocally();
+    if (_workerGroup) {
+        _workerGroup->abort();
+    }
+}
+
+void Orchestrator::abortLocally() {
     writer lock{_mutex};
     this->_errors = true;
     _phaseChange.notify_all();
 }
 
+void Orchestrator::joinWorkerGroup(v1::WorkerGroup& group) {
+    writer lock{_mutex};
+    assert(!_workerGroup);
+    _workerGroup = &group;
+    _groupWatcher = std::thread{[this]() { watchGroup(); }};
+}
+
+// Requires a writer lock on _mutex.
+void Orchestrator::arriveInGroup(bool runHooks) {
+    if (_arrivedInGroup) {
+        return;
+    }
+    _arrivedInGroup = true;
+    _workerGroup->arrive([&]() {
+        if (runHooks) {
+            for (auto&& cb : _prePhaseHooks) {
+                cb(this);
+            }
+        }
+    });
+}
+
+// Every worker arrives once per phase start and once per phase end, so transitions alternate
+// between the two just like `state` does.
+void Orchestrator::watchGroup() {
+    uint64_t seen = 0;
+    while (true) {
+        seen = _workerGroup->awaitTransition(seen, _stopWatchingGroup);
+        if (_stopWatchingGroup) {
+            return;
+        }
+        if (_workerGroup->aborted()) {
+            abortLocally();
+            return;
+        }
+
+        writer lock{_mutex};
+        _arrivedInGroup = false;
+        if (state == State::PhaseEnded) {
+            BOOST_LOG_TRIVIAL(debug) << "Beginning phase " << _current;
+            state = State::PhaseStarted;
+        } else {
+            ++_current;
+            BOOST_LOG_TRIVIAL(debug) << "Ended phase " << (this->_current - 1);
+            state = State::PhaseEnded;
+        }
+        _phaseChange.notify_all();
+        if (!morePhaseLogic(this->_current, this->_max, this->_errors)) {
+            return;
+        }
+    }
+}
+
 }  // namespace genny
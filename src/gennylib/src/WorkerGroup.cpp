@@ -0,0 +1,297 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gennylib/v1/WorkerGroup.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <pthread.h>
+
+#include <boost/interprocess/anonymous_shared_memory.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <gennylib/InvalidConfigurationException.hpp>
+
+namespace genny::v1 {
+
+namespace bip = boost::interprocess;
+
+namespace {
+
+constexpr size_t kMaxRateLimiterName = 128;
+// Long enough for the path of a ^FromFile dataset.
+constexpr size_t kMaxCounterName = 512;
+
+void check(int err, const char* what) {
+    if (err != 0) {
+        BOOST_THROW_EXCEPTION(std::system_error(err, std::generic_category(), what));
+    }
+}
+
+/**
+ * A mutex and condition variable shared between processes.
+ *
+ * On Linux the mutex is robust. If a worker dies while holding it, the next process to lock it
+ * gets it with `ownerDied` set instead of blocking forever. Boost's interprocess_mutex would
+ * stay locked, hanging the other workers and the coordinator's abort().
+ */
+class SharedMutex {
+public:
+    SharedMutex() {
+        pthread_mutexattr_t mutexAttr;
+        check(pthread_mutexattr_init(&mutexAttr), "pthread_mutexattr_init");
+        check(pthread_mutexattr_setpshared(&mutexAttr, PTHREAD_PROCESS_SHARED),
+              "pthread_mutexattr_setpshared");
+#ifdef __linux__
+        check(pthread_mutexattr_setrobust(&mutexAttr, PTHREAD_MUTEX_ROBUST),
+              "pthread_mutexattr_setrobust");
+#endif
+        check(pthread_mutex_init(&_mutex, &mutexAttr), "pthread_mutex_init");
+        pthread_mutexattr_destroy(&mutexAttr);
+
+        pthread_condattr_t condAttr;
+        check(pthread_condattr_init(&condAttr), "pthread_condattr_init");
+        check(pthread_condattr_setpshared(&condAttr, PTHREAD_PROCESS_SHARED),
+              "pthread_condattr_setpshared");
+        check(pthread_cond_init(&_cond, &condAttr), "pthread_cond_init");
+        pthread_condattr_destroy(&condAttr);
+    }
+
+    /**
+     * @return false if the previous owner died holding the mutex. It is locked either way.
+     */
+    bool lock() {
+        return recover(pthread_mutex_lock(&_mutex), "pthread_mutex_lock");
+    }
+
+    void unlock() {
+        pthread_mutex_unlock(&_mutex);
+    }
+
+    /**
+     * Wait for notifyAll(). The mutex must be held.
+     *
+     * @return false if another owner died holding the mutex while this one waited.
+     */
+    bool wait() {
+        return recover(pthread_cond_wait(&_cond, &_mutex), "pthread_cond_wait");
+    }
+
+    void notifyAll() {
+        pthread_cond_broadcast(&_cond);
+    }
+
+private:
+    bool recover(int err, const char* what) {
+#ifdef __linux__
+        if (err == EOWNERDEAD) {
+            pthread_mutex_consistent(&_mutex);
+            return false;
+        }
+#endif
+        check(err, what);
+        return true;
+    }
+
+    pthread_mutex_t _mutex;
+    pthread_cond_t _cond;
+};
+
+// Shared by processes, so atomics must not need a lock or a per-process table.
+static_assert(std::atomic_int64_t::is_always_lock_free);
+static_assert(std::atomic_bool::is_always_lock_free);
+
+}  // namespace
+
+// Everything in here is placed in memory shared by all workers. It must not hold pointers into
+// any one process's heap.
+struct WorkerGroup::State {
+    struct RateLimiterSlot {
+        char name[kMaxRateLimiterName] = {};
+        bool used = false;
+        std::aligned_storage_t<sizeof(GlobalRateLimiter), alignof(GlobalRateLimiter)> storage;
+
+        GlobalRateLimiter* get() {
+            return std::launder(reinterpret_cast<GlobalRateLimiter*>(&storage));
+        }
+    };
+
+    struct CounterSlot {
+        char name[kMaxCounterName] = {};
+        bool used = false;
+        std::atomic_int64_t value = 0;
+    };
+
+    explicit State(size_t workers) : workers{workers} {}
+
+    // Guards arrived and transitions. Notified on every transition and abort.
+    SharedMutex mutex;
+
+    const size_t workers;
+    size_t arrived = 0;
+    uint64_t transitions = 0;
+
+    std::atomic_bool aborted = false;
+
+    RateLimiterSlot rateLimiters[kMaxRateLimiters];
+    CounterSlot counters[kMaxCounters];
+};
+
+/**
+ * Holds State::mutex. Whatever a worker that died holding it was doing is left half done, and
+ * that worker will never arrive at the barrier again, so the group is aborted.
+ */
+class WorkerGroup::Lock {
+public:
+    explicit Lock(State& state) : _state{state} {
+        if (!_state.mutex.lock()) {
+            ownerDied();
+        }
+    }
+
+    ~Lock() {
+        _state.mutex.unlock();
+    }
+
+    Lock(const Lock&) = delete;
+    Lock& operator=(const Lock&) = delete;
+
+    void wait() {
+        if (!_state.mutex.wait()) {
+            ownerDied();
+        }
+    }
+
+private:
+    void ownerDied() {
+        _state.aborted = true;
+        _state.mutex.notifyAll();
+    }
+
+    State& _state;
+};
+
+WorkerGroup::WorkerGroup(size_t workers)
+    : _region{bip::anonymous_shared_memory(sizeof(State))}, _size{workers} {
+    if (workers == 0) {
+        BOOST_THROW_EXCEPTION(std::invalid_argument("Need at least one worker"));
+    }
+    _state = new (_region.get_address()) State{workers};
+}
+
+// The shared State is never destroyed: workers exit without running destructors on it and the
+// mapping goes away with the last process that has it.
+WorkerGroup::~WorkerGroup() = default;
+
+void WorkerGroup::joinAs(size_t index) {
+    if (index >= _size) {
+        BOOST_THROW_EXCEPTION(std::out_of_range("Worker index out of range"));
+    }
+    _index = index;
+}
+
+void WorkerGroup::arrive(const std::function<void()>& onLast) {
+    Lock lk{*_state};
+    if (++_state->arrived < _state->workers) {
+        return;
+    }
+    _state->arrived = 0;
+    onLast();
+    ++_state->transitions;
+    _state->mutex.notifyAll();
+}
+
+uint64_t WorkerGroup::awaitTransition(uint64_t seen, const std::atomic_bool& stop) {
+    Lock lk{*_state};
+    while (_state->transitions == seen && !_state->aborted && !stop) {
+        lk.wait();
+    }
+    return _state->transitions;
+}
+
+void WorkerGroup::wakeAll() {
+    Lock lk{*_state};
+    _state->mutex.notifyAll();
+}
+
+void WorkerGroup::abort() {
+    Lock lk{*_state};
+    _state->aborted = true;
+    _state->mutex.notifyAll();
+}
+
+bool WorkerGroup::aborted() const {
+    return _state->aborted;
+}
+
+GlobalRateLimiter* WorkerGroup::rateLimiter(const std::string& name, const RateSpec& spec) {
+    if (name.size() >= kMaxRateLimiterName) {
+        std::ostringstream msg;
+        msg << "RateLimiterName '" << name << "' is too long to share between workers. "
+            << "Use fewer than " << kMaxRateLimiterName << " characters.";
+        BOOST_THROW_EXCEPTION(InvalidConfigurationException(msg.str()));
+    }
+
+    Lock lk{*_state};
+    for (auto& slot : _state->rateLimiters) {
+        if (slot.used && name == slot.name) {
+            return slot.get();
+        }
+        if (!slot.used) {
+            std::strncpy(slot.name, name.c_str(), kMaxRateLimiterName - 1);
+            new (&slot.storage) GlobalRateLimiter{spec};
+            slot.used = true;
+            return slot.get();
+        }
+    }
+
+    std::ostringstream msg;
+    msg << "Workloads run with more than one worker can use at most " << kMaxRateLimiters
+        << " rate limiters.";
+    BOOST_THROW_EXCEPTION(InvalidConfigurationException(msg.str()));
+}
+
+std::atomic_int64_t& WorkerGroup::counter(const std::string& name) {
+    if (name.size() >= kMaxCounterName) {
+        std::ostringstream msg;
+        msg << "Counter name '" << name << "' is too long to share between workers. "
+            << "Use fewer than " << kMaxCounterName << " characters.";
+        BOOST_THROW_EXCEPTION(InvalidConfigurationException(msg.str()));
+    }
+
+    Lock lk{*_state};
+    for (auto& slot : _state->counters) {
+        if (slot.used && name == slot.name) {
+            return slot.value;
+        }
+        if (!slot.used) {
+            std::strncpy(slot.name, name.c_str(), kMaxCounterName - 1);
+            slot.used = true;
+            return slot.value;
+        }
+    }
+
+    std::ostringstream msg;
+    msg << "Workloads run with more than one worker can use at most " << kMaxCounters
+        << " shared counters.";
+    BOOST_THROW_EXCEPTION(InvalidConfigurationException(msg.str()));
+}
+
+}  // namespace genny::v1
@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <set>
+#include <stdexcept>
 #include <sstream>
 
 #include <mongocxx/instance.hpp>
@@ -24,6 +25,7 @@
 
 #include <gennylib/Cast.hpp>
 #include <gennylib/v1/Sleeper.hpp>
+#include <gennylib/v1/WorkerGroup.hpp>
 #include <metrics/metrics.hpp>
 
 namespace genny {
@@ -75,10 +77,30 @@ WorkloadContext::WorkloadContext(const Node& node,
 
     // Default value selected from random.org, by selecting 2 random numbers
     // between 1 and 10^9 and concatenating.
-    _rng.seed((*this)["RandomSeed"].maybe<long>().value_or(269849313357703264));
+    const auto seed = (*this)["RandomSeed"].maybe<long>().value_or(269849313357703264);
+    const auto seeding = (*this)["RandomSeeding"].maybe<std::string>().value_or("stream");
+    if (seeding == "counter") {
+        _counterSeed = static_cast<uint64_t>(seed);
+    } else if (seeding != "stream") {
+        BOOST_THROW_EXCEPTION(InvalidConfigurationException(
+            "Unknown RandomSeeding '" + seeding + "'. Need one of stream/counter"));
+    }
+    // Counter seeding re-seeds for every document, which costs Philox next to nothing.
+    auto engine = _counterSeed ? v1::EngineType::kPhilox4x64 : v1::EngineType::kMt19937_64;
+    if (auto name = (*this)["RandomEngine"].maybe<std::string>()) {
+        try {
+            engine = v1::parseEngineType(*name);
+        } catch (const std::invalid_argument& ex) {
+            BOOST_THROW_EXCEPTION(InvalidConfigurationException(ex.what()));
+        }
+    }
+    _rng = DefaultRandom{engine, static_cast<DefaultRandom::result_type>(seed)};
 
     for (auto& actorContext : _actorContexts) {
         for (auto&& actor : _constructActors(cast, actorContext)) {
+            if (const auto& cpuSet = actorContext->cpuSet()) {
+                _actorCpuSets.emplace(actor->id(), *cpuSet);
+            }
             _actors.push_back(std::move(actor));
         }
     }
@@ -116,11 +138,20 @@ GlobalRateLimiter* WorkloadContext::getRateLimiter(const std::string& name, cons
         BOOST_THROW_EXCEPTION(
             std::logic_error("Cannot create rate-limiters after setup. Name tried: " + name));
     }
-    if (_rateLimiters.count(name) == 0) {
-        _rateLimiters.emplace(std::make_pair(name, std::make_unique<GlobalRateLimiter>(spec)));
+    GlobalRateLimiter* rl;
+    if (auto group = _orchestrator->workerGroup()) {
+        rl = group->rateLimiter(name, spec);
+        // Every worker constructs every actor, so only one of them counts the users.
+        if (group->index() == 0) {
+            rl->addUser();
+        }
+    } else {
+        if (_rateLimiters.count(name) == 0) {
+            _rateLimiters.emplace(std::make_pair(name, std::make_unique<GlobalRateLimiter>(spec)));
+        }
+        rl = _rateLimiters[name].get();
+        rl->addUser();
     }
-    auto rl = _rateLimiters[name].get();
-    rl->addUser();
 
     // Reset the rate-limiter at the start of every Phase
     this->_orchestrator->addPrePhaseStartHook(
@@ -134,7 +165,9 @@ DefaultRandom& WorkloadContext::getRNGForThread(ActorId id) {
         BOOST_THROW_EXCEPTION(std::logic_error("Cannot create RNGs after setup"));
     }
     if (auto rng = _rngRegistry.find(id); rng == _rngRegistry.end()) {
-        auto [it, success] = _rngRegistry.try_emplace(id, _rng());
+        // With counter seeding an Actor's values don't depend on how many came before it.
+        const auto seed = _counterSeed ? v1::mixSeed(*_counterSeed, id) : _rng();
+        auto [it, success] = _rngRegistry.try_emplace(id, _rng.engineType(), seed);
         if (!success) {
             // This should be impossible.
             // But invariants don't hurt we only call this during setup
@@ -144,6 +177,13 @@ DefaultRandom& WorkloadContext::getRNGForThread(ActorId id) {
     return _rngRegistry[id];
 }
 
+DefaultRandom WorkloadContext::createRNG() {
+    if (this->isDone()) {
+        BOOST_THROW_EXCEPTION(std::logic_error("Cannot create RNGs after setup"));
+    }
+    return _rng.child();
+}
+
 // Helper method to convert Phases:[...] to PhaseContexts
 std::unordered_map<PhaseNumber, std::unique_ptr<PhaseContext>> ActorContext::constructPhaseContexts(
     const Node&, ActorContext* actorContext) {
@@ -0,0 +1,122 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+#include <gennylib/Orchestrator.hpp>
+#include <gennylib/v1/ActorScheduler.hpp>
+
+#include <testlib/helpers.hpp>
+
+namespace genny {
+namespace {
+
+using v1::ActorScheduler;
+using namespace std::chrono_literals;
+
+TEST_CASE("ActorScheduler requires worker threads") {
+    REQUIRE_THROWS_AS(ActorScheduler{0}, std::invalid_argument);
+}
+
+TEST_CASE("ActorScheduler runs every task") {
+    // Catch2's REQUIRE etc macros are not thread-safe, so count from the tasks instead.
+    std::atomic_int ran = 0;
+    std::atomic_int cooperative = 0;
+    std::vector<ActorScheduler::Task> tasks;
+    for (int i = 0; i < 1000; ++i) {
+        tasks.emplace_back([&]() {
+            cooperative += ActorScheduler::isCooperative();
+            ActorScheduler::yield();
+            ++ran;
+        });
+    }
+
+    ActorScheduler{3}.run(std::move(tasks));
+
+    REQUIRE(ran == 1000);
+    REQUIRE(cooperative == 1000);
+    REQUIRE(!ActorScheduler::isCooperative());
+}
+
+TEST_CASE("ActorScheduler uses a bounded number of threads") {
+    std::mutex lock;
+    std::set<std::thread::id> threads;
+    std::vector<ActorScheduler::Task> tasks;
+    for (int i = 0; i < 100; ++i) {
+        tasks.emplace_back([&]() {
+            for (int j = 0; j < 10; ++j) {
+                {
+                    std::lock_guard<std::mutex> lk{lock};
+                    threads.insert(std::this_thread::get_id());
+                }
+                ActorScheduler::yield();
+            }
+        });
+    }
+
+    ActorScheduler{2}.run(std::move(tasks));
+
+    REQUIRE(threads.size() <= 2);
+}
+
+TEST_CASE("ActorScheduler sleeps don't hold the worker thread") {
+    std::vector<ActorScheduler::Task> tasks;
+    for (int i = 0; i < 50; ++i) {
+        tasks.emplace_back([]() { ActorScheduler::sleep_for(100ms); });
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    ActorScheduler{1}.run(std::move(tasks));
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+
+    // 50 sequential sleeps would take 5 seconds.
+    REQUIRE(elapsed >= 100ms);
+    REQUIRE(elapsed < 2s);
+}
+
+TEST_CASE("More actors than worker threads progress through Orchestrator phases") {
+    constexpr int kActors = 200;
+
+    Orchestrator o;
+    o.addRequiredTokens(kActors);
+    o.phasesAtLeastTo(2);
+
+    std::atomic_int phaseEnds = 0;
+    std::vector<ActorScheduler::Task> tasks;
+    for (int i = 0; i < kActors; ++i) {
+        tasks.emplace_back([&]() {
+            while (o.morePhases()) {
+                // Every actor blocks until all others have started the phase.
+                // This deadlocks if waiting holds a worker thread.
+                o.awaitPhaseStart();
+                ActorScheduler::yield();
+                o.awaitPhaseEnd();
+                ++phaseEnds;
+            }
+        });
+    }
+
+    ActorScheduler{2}.run(std::move(tasks));
+
+    REQUIRE(phaseEnds == kActors * 3);
+    REQUIRE(o.currentPhase() == 3);
+}
+
+}  // namespace
+}  // namespace genny
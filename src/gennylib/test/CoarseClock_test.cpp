@@ -0,0 +1,83 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include <gennylib/v1/CoarseClock.hpp>
+
+#include <testlib/helpers.hpp>
+
+namespace genny {
+namespace {
+
+using v1::CoarseClock;
+using namespace std::chrono_literals;
+
+void requireNeverAhead(std::chrono::nanoseconds maxLag) {
+    for (int i = 0; i < 1000; ++i) {
+        const auto coarse = CoarseClock::now();
+        const auto precise = std::chrono::steady_clock::now();
+        REQUIRE(coarse <= precise);
+        REQUIRE(precise - coarse <= maxLag);
+    }
+}
+
+TEST_CASE("CoarseClock sources") {
+    SECTION("Precise by default") {
+        REQUIRE(CoarseClock::mode() == CoarseClock::Mode::kPrecise);
+        requireNeverAhead(10ms);
+    }
+
+    SECTION("Kernel coarse clock") {
+        CoarseClock::Source source{CoarseClock::Mode::kKernel};
+        REQUIRE(CoarseClock::mode() == CoarseClock::Mode::kKernel);
+        // Kernel ticks are at most 10ms (CONFIG_HZ=100).
+        requireNeverAhead(20ms);
+    }
+
+    SECTION("Ticker advances") {
+        {
+            CoarseClock::Source source{CoarseClock::Mode::kTicker, 1ms};
+            REQUIRE(CoarseClock::mode() == CoarseClock::Mode::kTicker);
+
+            const auto first = CoarseClock::now();
+            std::this_thread::sleep_for(20ms);
+            REQUIRE(CoarseClock::now() - first >= 10ms);
+            // Generous for loaded CI hosts.
+            requireNeverAhead(100ms);
+        }
+        REQUIRE(CoarseClock::mode() == CoarseClock::Mode::kPrecise);
+    }
+
+    SECTION("Only one source at a time") {
+        CoarseClock::Source source{CoarseClock::Mode::kKernel};
+        REQUIRE_THROWS_AS(CoarseClock::Source{CoarseClock::Mode::kTicker}, std::logic_error);
+    }
+
+    SECTION("Only one source at a time, even a precise one") {
+        {
+            CoarseClock::Source precise{CoarseClock::Mode::kPrecise};
+            REQUIRE_THROWS_AS(CoarseClock::Source{CoarseClock::Mode::kKernel}, std::logic_error);
+        }
+        // The failed Source didn't change the mode or leave the slot taken.
+        REQUIRE(CoarseClock::mode() == CoarseClock::Mode::kPrecise);
+        CoarseClock::Source kernel{CoarseClock::Mode::kKernel};
+        REQUIRE(CoarseClock::mode() == CoarseClock::Mode::kKernel);
+    }
+}
+
+}  // namespace
+}  // namespace genny
@@ -0,0 +1,138 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <mongocxx/client.hpp>
+#include <mongocxx/instance.hpp>
+#include <mongocxx/uri.hpp>
+
+#include <gennylib/ActorProducer.hpp>
+#include <gennylib/Cast.hpp>
+#include <gennylib/CollectionSelector.hpp>
+#include <gennylib/InvalidConfigurationException.hpp>
+#include <gennylib/Node.hpp>
+#include <gennylib/context.hpp>
+
+#include <testlib/helpers.hpp>
+
+namespace genny {
+namespace {
+
+using Catch::Matchers::StartsWith;
+
+// The driver doesn't connect until it is used, so no server is needed.
+constexpr auto kMongoUri = "mongodb://localhost:27017";
+
+struct PhaseProducer : public ActorProducer {
+    PhaseProducer(std::function<void(PhaseContext&)> op) : ActorProducer("Op"), _op(op) {}
+
+    ActorVector produce(ActorContext& context) override {
+        _op(*context.phases().at(0));
+        return {};
+    }
+
+    std::function<void(PhaseContext&)> _op;
+};
+
+/**
+ * Run `op` on the only phase of an actor configured by `phaseYaml`.
+ */
+void onPhase(const std::string& phaseYaml, std::function<void(PhaseContext&)> op) {
+    Orchestrator orchestrator{};
+    auto cast = Cast{{"Op", std::make_shared<PhaseProducer>(op)}};
+    NodeSource ns{"SchemaVersion: 2018-07-01\nActors: [{Type: Op, Phases: [" + phaseYaml + "]}]",
+                  ""};
+    WorkloadContext{ns.root(), orchestrator, kMongoUri, cast};
+}
+
+std::vector<std::string> names(CollectionSelector& selector, DefaultRandom& rng, int n) {
+    std::vector<std::string> out;
+    for (int i = 0; i < n; ++i) {
+        out.push_back(selector(rng).name().to_string());
+    }
+    return out;
+}
+
+TEST_CASE("CollectionSelector") {
+    mongocxx::instance::current();
+    mongocxx::client client{mongocxx::uri{kMongoUri}};
+    auto database = client["test"];
+    DefaultRandom rng{7};
+
+    SECTION("Names collections after CollectionName") {
+        onPhase("{CollectionCount: 3, CollectionName: 'c_%d_x', CollectionSelection: roundRobin}",
+                [&](PhaseContext& phase) {
+                    CollectionSelector selector{phase, database, 0};
+                    REQUIRE(selector.size() == 3);
+                    REQUIRE(names(selector, rng, 4) ==
+                            std::vector<std::string>{"c_0_x", "c_1_x", "c_2_x", "c_0_x"});
+                });
+    }
+
+    SECTION("Round robin starts at a different collection for each actor") {
+        onPhase("{CollectionCount: 3, CollectionSelection: roundRobin}", [&](PhaseContext& phase) {
+            CollectionSelector selector{phase, database, 4};
+            REQUIRE(names(selector, rng, 3) ==
+                    std::vector<std::string>{"Collection1", "Collection2", "Collection0"});
+        });
+    }
+
+    SECTION("Uniform and zipfian pick every collection") {
+        for (auto selection : {"uniform", "zipfian"}) {
+            onPhase(std::string{"{CollectionCount: 4, CollectionSelection: "} + selection + "}",
+                    [&](PhaseContext& phase) {
+                        CollectionSelector selector{phase, database, 1};
+                        std::vector<int> counts(4);
+                        for (int i = 0; i < 10000; ++i) {
+                            ++counts.at(selector.nextIndex(rng));
+                        }
+                        INFO(selection);
+                        for (auto count : counts) {
+                            REQUIRE(count > 0);
+                        }
+                        if (selection == std::string{"zipfian"}) {
+                            REQUIRE(counts[0] > counts[1]);
+                            REQUIRE(counts[1] > counts[3]);
+                        }
+                    });
+        }
+    }
+
+    SECTION("Selects from given names") {
+        onPhase("{}", [&](PhaseContext& phase) {
+            CollectionSelector selector{phase, database, {"only"}, 1};
+            REQUIRE(names(selector, rng, 2) == std::vector<std::string>{"only", "only"});
+        });
+    }
+
+    SECTION("Rejects bad configuration") {
+        auto rejects = [&](const std::string& phaseYaml, const std::string& message) {
+            onPhase(phaseYaml, [&](PhaseContext& phase) {
+                REQUIRE_THROWS_WITH((CollectionSelector{phase, database, 1}), StartsWith(message));
+            });
+        };
+        rejects("{CollectionCount: 2, CollectionSelection: sometimes}",
+                "Unknown CollectionSelection 'sometimes'");
+        rejects("{CollectionCount: 2, CollectionName: fixed}", "CollectionName 'fixed' needs");
+        rejects("{CollectionCount: 0}", "Need at least one collection");
+        rejects("{CollectionCount: 2, CollectionSelection: zipfian, CollectionSkew: 1.5}",
+                "CollectionSkew must be between 0 and 1");
+    }
+}
+
+}  // namespace
+}  // namespace genny
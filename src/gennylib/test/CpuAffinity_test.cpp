@@ -0,0 +1,73 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <set>
+#include <thread>
+
+#include <gennylib/InvalidConfigurationException.hpp>
+#include <gennylib/v1/CpuAffinity.hpp>
+
+#include <testlib/helpers.hpp>
+
+namespace genny {
+namespace {
+
+using v1::CpuSet;
+
+TEST_CASE("CpuSet parsing") {
+    SECTION("Single cpus and ranges") {
+        REQUIRE(CpuSet{"3"}.cpus() == std::set<int>{3});
+        REQUIRE(CpuSet{"0-3,8, 10-11"}.cpus() == std::set<int>{0, 1, 2, 3, 8, 10, 11});
+        REQUIRE(CpuSet{"5,1,5"}.cpus() == std::set<int>{1, 5});
+    }
+
+    SECTION("Canonical string form") {
+        REQUIRE(CpuSet{"0-3,8, 10-11"}.toString() == "0-3,8,10-11");
+        REQUIRE(CpuSet{"4,2,3"}.toString() == "2-4");
+        REQUIRE(CpuSet{"7"}.toString() == "7");
+    }
+
+    SECTION("Invalid specs") {
+        REQUIRE_THROWS_AS(CpuSet{""}, InvalidConfigurationException);
+        REQUIRE_THROWS_AS(CpuSet{"a"}, InvalidConfigurationException);
+        REQUIRE_THROWS_AS(CpuSet{"3-1"}, InvalidConfigurationException);
+        REQUIRE_THROWS_AS(CpuSet{"-1"}, InvalidConfigurationException);
+        REQUIRE_THROWS_AS(CpuSet{"node99999"}, InvalidConfigurationException);
+        REQUIRE_THROWS_AS(CpuSet{"99999999999999999999"}, InvalidConfigurationException);
+        REQUIRE_THROWS_AS(CpuSet{"0-99999999999"}, InvalidConfigurationException);
+        REQUIRE_THROWS_AS(CpuSet{"0-2000000000"}, InvalidConfigurationException);
+        REQUIRE_THROWS_AS(CpuSet{"node"}, InvalidConfigurationException);
+        REQUIRE_THROWS_AS(CpuSet{"node0/../../cpu"}, InvalidConfigurationException);
+    }
+}
+
+TEST_CASE("CpuSet pinning") {
+    const auto initial = CpuSet::ofCurrentThread();
+    REQUIRE(!initial.cpus().empty());
+
+    // Run in a separate thread so the test runner's own affinity isn't changed.
+    std::set<int> pinned;
+    std::thread{[&]() {
+        CpuSet{std::to_string(*initial.cpus().begin())}.pinCurrentThread();
+        pinned = CpuSet::ofCurrentThread().cpus();
+    }}.join();
+
+#ifdef __linux__
+    REQUIRE(pinned == std::set<int>{*initial.cpus().begin()});
+#endif
+    REQUIRE(CpuSet::ofCurrentThread() == initial);
+}
+
+}  // namespace
+}  // namespace genny
@@ -440,21 +440,55 @@ TEST_CASE("Actual Actor Example") {
             - Type: Inc
               Name: Inc
               Phases:
-              - Repeat: 3
-                SleepBefore: 10 milliseconds
-                SleepAfter: 100 milliseconds
-                GlobalRate: 20 per 30 milliseconds
+              - Repeat: 10
+                SleepBefore: 1 milliseconds
+                SleepAfter: 2 milliseconds
+                GlobalRate: 1 per 30 milliseconds
                 Key: 71
         )",
                           "");
 
         auto imvProducer = std::make_shared<CounterProducer<IncrementsMapValues>>("Inc");
+        ActorHelper ah(config.root(), 1, {{"Inc", imvProducer}});
 
-        REQUIRE_THROWS_WITH(([&]() {
-                                ActorHelper ah(config.root(), 1, {{"Inc", imvProducer}});
-                                ah.run();
-                            }()),
-                            Catch::Matches(R"(GlobalRate must \*not\* be specified alongside .*)"));
+        auto start = std::chrono::steady_clock::now();
+        ah.run();
+        auto duration = std::chrono::steady_clock::now() - start;
+
+        REQUIRE(imvProducer->counters == std::unordered_map<int, int>{{72, 10}});
+        // The think time alone would take about 30ms. The GlobalRate still caps the
+        // 10 iterations to at most one per 30ms. No upper bound: a loaded host can always be
+        // slower.
+        REQUIRE(duration >= 270ms);
+    }
+
+    SECTION("Random think times") {
+        using namespace std::literals::chrono_literals;
+        NodeSource config(R"(
+            SchemaVersion: 2018-07-01
+            RandomSeed: 269849313357703264
+            Actors:
+            - Type: Inc
+              Name: Inc
+              Phases:
+              - Repeat: 20
+                SleepBefore: {Distribution: uniform, Min: 0 milliseconds, Max: 10 milliseconds}
+                SleepAfter: {Distribution: exponential, Mean: 5 milliseconds}
+                Key: 71
+        )",
+                          "");
+
+        auto imvProducer = std::make_shared<CounterProducer<IncrementsMapValues>>("Inc");
+        ActorHelper ah(config.root(), 1, {{"Inc", imvProducer}});
+
+        auto start = std::chrono::steady_clock::now();
+        ah.run();
+        auto duration = std::chrono::steady_clock::now() - start;
+
+        REQUIRE(imvProducer->counters == std::unordered_map<int, int>{{72, 20}});
+        // Means of 5ms each over 20 iterations. The seed is fixed, so the sleeps are too, and
+        // they add up to well over this.
+        REQUIRE(duration > 50ms);
     }
 
     SECTION("SleepBefore = 0") {
@@ -0,0 +1,214 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <new>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <boost/interprocess/anonymous_shared_memory.hpp>
+
+#include <gennylib/InvalidConfigurationException.hpp>
+#include <gennylib/Orchestrator.hpp>
+#include <gennylib/v1/WorkerGroup.hpp>
+
+#include <testlib/helpers.hpp>
+
+namespace genny {
+namespace {
+
+using namespace std::chrono_literals;
+
+// Catch2 can't assert in a forked child, so children record results here and the parent
+// checks them after the child exits.
+struct Results {
+    std::atomic_int phasesEndedByChild[3] = {};
+    std::atomic_int violations = 0;
+    std::atomic_int consumed = 0;
+};
+
+class SharedResults {
+public:
+    SharedResults()
+        : _region{boost::interprocess::anonymous_shared_memory(sizeof(Results))},
+          _results{new (_region.get_address()) Results{}} {}
+
+    Results* operator->() {
+        return _results;
+    }
+
+private:
+    boost::interprocess::mapped_region _region;
+    Results* _results;
+};
+
+/**
+ * Run `fn` as worker 1 in a child process.
+ */
+template <typename F>
+pid_t forkWorker(v1::WorkerGroup& group, F&& fn) {
+    const pid_t pid = fork();
+    if (pid == 0) {
+        group.joinAs(1);
+        fn();
+        _exit(0);
+    }
+    return pid;
+}
+
+int waitFor(pid_t pid) {
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+TEST_CASE("Workers change phases together") {
+    v1::WorkerGroup group{2};
+    SharedResults results;
+
+    auto runPhases = [&](bool isChild) {
+        Orchestrator o;
+        o.phasesAtLeastTo(2);
+        o.addRequiredTokens(1);
+        o.joinWorkerGroup(group);
+        while (o.morePhases()) {
+            const auto phase = o.awaitPhaseStart();
+            if (isChild) {
+                // Make the child the slow one so the parent has to wait for it.
+                std::this_thread::sleep_for(20ms);
+                ++results->phasesEndedByChild[phase];
+            }
+            o.awaitPhaseEnd();
+            if (!isChild && results->phasesEndedByChild[phase] != 1) {
+                ++results->violations;
+            }
+        }
+    };
+
+    const pid_t child = forkWorker(group, [&]() { runPhases(true); });
+    runPhases(false);
+
+    REQUIRE(waitFor(child) == 0);
+    REQUIRE(results->violations == 0);
+    for (const auto& ended : results->phasesEndedByChild) {
+        REQUIRE(ended == 1);
+    }
+}
+
+TEST_CASE("Aborting one worker aborts the others") {
+    v1::WorkerGroup group{2};
+
+    const pid_t child = forkWorker(group, [&]() {
+        Orchestrator o;
+        o.addRequiredTokens(1);
+        o.joinWorkerGroup(group);
+        o.awaitPhaseStart();
+        o.abort();
+    });
+
+    Orchestrator o;
+    o.addRequiredTokens(1);
+    o.joinWorkerGroup(group);
+    o.awaitPhaseStart();
+    // Would block forever if the child's abort didn't reach us.
+    o.awaitPhaseEnd();
+
+    REQUIRE(waitFor(child) == 0);
+    REQUIRE(!o.continueRunning());
+    REQUIRE(group.aborted());
+}
+
+#ifdef __linux__
+TEST_CASE("A worker dying while holding the lock aborts the group") {
+    v1::WorkerGroup group{2};
+
+    const pid_t child = fork();
+    if (child == 0) {
+        group.joinAs(1);
+        group.arrive([]() {});
+        // Called by the last worker to arrive, with the group's lock held.
+        group.arrive([]() { _exit(3); });
+        _exit(0);
+    }
+    REQUIRE(waitFor(child) == 3);
+
+    // Would block forever if the dead child's lock were never released. The child died before
+    // completing the transition.
+    std::atomic_bool stop = false;
+    REQUIRE(group.awaitTransition(0, stop) == 0);
+    REQUIRE(group.aborted());
+    group.abort();
+}
+#endif
+
+TEST_CASE("Workers share rate limiters") {
+    v1::WorkerGroup group{2};
+    SharedResults results;
+
+    const auto spec = YAML::Load("1 per 10 milliseconds").as<RateSpec>();
+    auto rl = group.rateLimiter("shared", spec);
+    REQUIRE(group.rateLimiter("shared", spec) == rl);
+    REQUIRE(group.rateLimiter("other", spec) != rl);
+    rl->resetLastEmptied();
+
+    auto consume = [&]() {
+        const auto stop = SteadyClock::now() + 200ms;
+        while (SteadyClock::now() < stop) {
+            if (rl->consumeIfWithinRate(SteadyClock::now())) {
+                ++results->consumed;
+            }
+        }
+    };
+
+    const pid_t child = forkWorker(group, consume);
+    consume();
+    REQUIRE(waitFor(child) == 0);
+
+    // Each process alone would get about 20.
+    REQUIRE(results->consumed >= 15);
+    REQUIRE(results->consumed <= 25);
+}
+
+TEST_CASE("Workers share counters") {
+    v1::WorkerGroup group{2};
+
+    auto& counter = group.counter("shared");
+    REQUIRE(&group.counter("shared") == &counter);
+    REQUIRE(&group.counter("other") != &counter);
+
+    auto count = [&]() {
+        for (int i = 0; i < 1000; ++i) {
+            group.counter("shared").fetch_add(1);
+        }
+    };
+
+    // A counter first used after the fork is shared too.
+    const pid_t child = forkWorker(group, [&]() {
+        count();
+        group.counter("late") += 5;
+    });
+    count();
+    REQUIRE(waitFor(child) == 0);
+
+    REQUIRE(counter == 2000);
+    REQUIRE(group.counter("late") == 5);
+    REQUIRE_THROWS_AS(group.counter(std::string(1000, 'x')), InvalidConfigurationException);
+}
+
+}  // namespace
+}  // namespace genny
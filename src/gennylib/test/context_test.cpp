@@ -19,6 +19,7 @@
 #include <optional>
 #include <string_view>
 #include <thread>
+#include <vector>
 
 #include <yaml-cpp/yaml.h>
 
@@ -164,6 +165,79 @@ Actors:
         REQUIRE(calls == 2);
     }
 
+    SECTION("RandomEngine picks the engine") {
+        std::optional<v1::EngineType> actorEngine;
+        std::optional<v1::EngineType> createdEngine;
+        auto producer = std::make_shared<OpProducer>([&](ActorContext& a) {
+            actorEngine = a.workload().getRNGForThread(a.workload().nextActorId()).engineType();
+            createdEngine = a.workload().createRNG().engineType();
+        });
+        auto cast2 = Cast{{{"Op", producer}}};
+
+        auto engineFor = [&](const std::string& engineYaml) {
+            auto yaml = NodeSource(
+                "SchemaVersion: 2018-07-01\n" + engineYaml + "Actors: [{Type: Op}]", "");
+            WorkloadContext w(yaml.root(), orchestrator, mongoUri.data(), cast2);
+            REQUIRE(actorEngine == createdEngine);
+            return *actorEngine;
+        };
+
+        REQUIRE(engineFor("") == v1::EngineType::kMt19937_64);
+        REQUIRE(engineFor("RandomEngine: pcg64\n") == v1::EngineType::kPcg64);
+        REQUIRE(engineFor("RandomEngine: philox4x64\n") == v1::EngineType::kPhilox4x64);
+        REQUIRE_THROWS_WITH(engineFor("RandomEngine: rand\n"),
+                            StartsWith("Unknown RandomEngine 'rand'"));
+    }
+
+    SECTION("RandomSeeding: counter seeds Actors by id") {
+        std::vector<uint64_t> firstValues;
+        std::optional<uint64_t> counterSeed;
+        v1::EngineType engine;
+        auto producer = std::make_shared<OpProducer>([&](ActorContext& a) {
+            auto& workload = a.workload();
+            // Drawing from the workload's stream first doesn't change the actor's values.
+            workload.createRNG();
+            firstValues.push_back(workload.getRNGForThread(workload.nextActorId())());
+            counterSeed = workload.counterSeed();
+            engine = workload.randomEngine();
+        });
+        auto cast2 = Cast{{{"Op", producer}}};
+
+        auto yaml = NodeSource(
+            "SchemaVersion: 2018-07-01\n"
+            "RandomSeed: 7\n"
+            "RandomSeeding: counter\n"
+            "Actors: [{Type: Op}]",
+            "");
+        WorkloadContext w(yaml.root(), orchestrator, mongoUri.data(), cast2);
+        REQUIRE(counterSeed == 7);
+        REQUIRE(engine == v1::EngineType::kPhilox4x64);
+        REQUIRE(firstValues.size() == 1);
+        DefaultRandom expected{v1::EngineType::kPhilox4x64, v1::mixSeed(7, 1)};
+        REQUIRE(firstValues[0] == expected());
+
+        auto bad = NodeSource(
+            "SchemaVersion: 2018-07-01\nRandomSeeding: sometimes\nActors: [{Type: Op}]", "");
+        REQUIRE_THROWS_WITH(
+            [&]() { WorkloadContext w2(bad.root(), orchestrator, mongoUri.data(), cast2); }(),
+            StartsWith("Unknown RandomSeeding 'sometimes'"));
+    }
+
+    SECTION("ActorContext knows its actors' ids") {
+        std::vector<std::optional<size_t>> indexes;
+        auto producer = std::make_shared<OpProducer>([&](ActorContext& a) {
+            const auto first = a.nextActorId();
+            const auto second = a.nextActorId();
+            const auto other = a.workload().nextActorId();
+            indexes = {a.actorIndex(first), a.actorIndex(second), a.actorIndex(other)};
+        });
+        auto cast2 = Cast{{{"Op", producer}}};
+
+        auto yaml = NodeSource("SchemaVersion: 2018-07-01\nActors: [{Type: Op}]", "");
+        WorkloadContext w(yaml.root(), orchestrator, mongoUri.data(), cast2);
+        REQUIRE(indexes == std::vector<std::optional<size_t>>{0, 1, std::nullopt});
+    }
+
     SECTION("Invalid config accesses") {
         // key not found
         errors<string>("Foo: bar", "Invalid key 'FoO'", "FoO");
@@ -98,6 +98,58 @@ TEST_CASE("genny::TimeSpec conversions") {
     }
 }
 
+TEST_CASE("genny::ThinkTimeSpec conversions") {
+    using Distribution = ThinkTimeSpec::Distribution;
+
+    SECTION("A TimeSpec is a fixed think time") {
+        auto spec = YAML::Load("20 milliseconds").as<ThinkTimeSpec>();
+        REQUIRE(spec.distribution == Distribution::kFixed);
+        REQUIRE(spec.min.count() == 20 * std::pow(10, 6));
+        REQUIRE(spec.max.count() == 20 * std::pow(10, 6));
+        REQUIRE(!spec.isRandom());
+        REQUIRE(bool(spec));
+        REQUIRE(!bool(YAML::Load("0 milliseconds").as<ThinkTimeSpec>()));
+    }
+
+    SECTION("Can convert distributions") {
+        auto fixed =
+            YAML::Load("{Distribution: fixed, Value: 3 seconds}").as<ThinkTimeSpec>();
+        REQUIRE(fixed.distribution == Distribution::kFixed);
+        REQUIRE(fixed.min.count() == 3 * std::pow(10, 9));
+
+        auto uniform = YAML::Load("{Distribution: uniform, Min: 1 second, Max: 3 seconds}")
+                           .as<ThinkTimeSpec>();
+        REQUIRE(uniform.distribution == Distribution::kUniform);
+        REQUIRE(uniform.min.count() == 1 * std::pow(10, 9));
+        REQUIRE(uniform.max.count() == 3 * std::pow(10, 9));
+        REQUIRE(uniform.isRandom());
+
+        auto exponential =
+            YAML::Load("{Distribution: exponential, Mean: 5 milliseconds}").as<ThinkTimeSpec>();
+        REQUIRE(exponential.distribution == Distribution::kExponential);
+        REQUIRE(exponential.mean.count() == 5 * std::pow(10, 6));
+        REQUIRE(exponential.isRandom());
+    }
+
+    SECTION("Barfs on invalid values") {
+        REQUIRE_THROWS(YAML::Load("-1 nanosecond").as<ThinkTimeSpec>());
+        REQUIRE_THROWS(YAML::Load("[1,2,3]").as<ThinkTimeSpec>());
+        REQUIRE_THROWS(YAML::Load("{Distribution: normal, Mean: 1 second}").as<ThinkTimeSpec>());
+        REQUIRE_THROWS(YAML::Load("{Distribution: uniform, Min: 1 second}").as<ThinkTimeSpec>());
+        REQUIRE_THROWS(YAML::Load("{Distribution: uniform, Min: 2 seconds, Max: 1 second}")
+                           .as<ThinkTimeSpec>());
+    }
+
+    SECTION("Can encode") {
+        YAML::Node n;
+        n["SleepAfter"] = ThinkTimeSpec::uniform(TimeSpec{10}, TimeSpec{20});
+        auto spec = n["SleepAfter"].as<ThinkTimeSpec>();
+        REQUIRE(spec.distribution == Distribution::kUniform);
+        REQUIRE(spec.min.count() == 10);
+        REQUIRE(spec.max.count() == 20);
+    }
+}
+
 TEST_CASE("genny::IntegerSpec conversions") {
     SECTION("Can convert to genny::IntegerSpec") {
         REQUIRE(YAML::Load("Repeat: 300")["Repeat"].as<IntegerSpec>().value == 300);
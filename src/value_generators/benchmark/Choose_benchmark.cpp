@@ -0,0 +1,81 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/random/discrete_distribution.hpp>
+
+#include <gennylib/Node.hpp>
+
+#include <testlib/helpers.hpp>
+
+#include <value_generators/DefaultRandom.hpp>
+#include <value_generators/DocumentGenerator.hpp>
+
+#include "weightedChoice.hpp"
+
+namespace genny {
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+constexpr int kIterations = 200000;
+
+double nanosPer(clock::duration elapsed, int count) {
+    return double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / count;
+}
+
+void report(size_t size) {
+    NodeSource ns{"a: " + weightedChoice(size), ""};
+    DefaultRandom rng;
+    DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1}};
+    DocumentGenerator::Buffer buffer;
+
+    size_t bytes = 0;
+    auto start = clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        bytes += docGen.evaluateInto(buffer).length();
+    }
+    const auto perDocument = nanosPer(clock::now() - start, kIterations);
+
+    // What ^Choose used to do: build the distribution for every value.
+    const auto weights = choiceWeights(size);
+    const int rebuilds = std::max<int>(10, kIterations / int(size));
+    size_t sum = 0;
+    start = clock::now();
+    for (int i = 0; i < rebuilds; ++i) {
+        sum += boost::random::discrete_distribution<>(weights)(rng);
+    }
+    const auto perRebuild = nanosPer(clock::now() - start, rebuilds);
+
+    std::cout << "^Choose from " << size << " weighted constants: " << perDocument
+              << " ns per document, vs " << perRebuild
+              << " ns per value rebuilding the distribution" << std::endl;
+    REQUIRE(bytes > 0);
+    REQUIRE(sum < size * rebuilds);
+}
+
+}  // namespace
+
+TEST_CASE("^Choose throughput", "[benchmark]") {
+    for (size_t size : {2, 10, 100, 1000, 10000, 100000}) {
+        report(size);
+    }
+}
+
+}  // namespace genny
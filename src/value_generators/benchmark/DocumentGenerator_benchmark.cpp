@@ -0,0 +1,218 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gennylib/Node.hpp>
+
+#include <testlib/helpers.hpp>
+
+#include <value_generators/DefaultRandom.hpp>
+#include <value_generators/DocumentGenerator.hpp>
+
+#include "weightedChoice.hpp"
+
+namespace genny {
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+// How long each template runs for on each thread count, after warming up.
+constexpr auto kDuration = std::chrono::milliseconds{500};
+constexpr auto kWarmup = std::chrono::milliseconds{50};
+
+// Documents generated between looks at the clock.
+constexpr int kChunk = 64;
+
+struct Template {
+    const char* name;
+    std::string yaml;
+};
+
+std::vector<Template> templates() {
+    return {
+        // From scale/LLTInsert.yml.
+        {"small flat",
+         R"({
+            caid: {^RandomInt: {min: 0, max: 1000}},
+            cuid: {^RandomInt: {min: 0, max: 100000}},
+            prod: {^RandomInt: {min: 0, max: 10000}},
+            prid: {^RandomDouble: {min: 0.0, max: 1000.0}},
+            data: {^Join: {array: [
+                "aaaaaaaaaa",
+                {^FastRandomString: {length: {^RandomInt: {min: 0, max: 10}}}}]}}
+         })"},
+        {"nested arrays",
+         R"({
+            user: {
+                name: {^RandomString: {length: 12}},
+                tags: [red, green, {^Choose: {from: [blue, cyan, teal]}}],
+                scores: [{^RandomInt: {min: 0, max: 100}},
+                         {^RandomInt: {min: 0, max: 100}},
+                         {^RandomDouble: {min: 0.0, max: 1.0}}]
+            },
+            history: [
+                {at: {^RandomDate: {min: "2020-01-01", max: "2021-01-01"}}, n: {^Inc: {}}},
+                {at: {^RandomDate: {min: "2020-01-01", max: "2021-01-01"}}, n: {^Inc: {}}},
+                [[1, 2, [3, {^RandomInt: {min: 0, max: 9}}]], {deep: {deeper: [x, y]}}]
+            ]
+         })"},
+        // Like the large strings of contrib/historystore/eMRCf*.yml, but 16KB.
+        {"16KB ^RandomString", "{payload: {^RandomString: {length: 16384}}}"},
+        {"16KB ^FastRandomString", "{payload: {^FastRandomString: {length: 16384}}}"},
+        {"heavy ^Choose",
+         "{word: " + weightedChoice(1000) + R"(,
+            doc: {^Choose: {from: [{a: 1}, {b: {^RandomInt: {min: 0, max: 10}}}, {c: [x, y]}],
+                            weights: [5, 3, 1]}},
+            number: {^Choose: {from: [{^RandomInt: {min: 0, max: 10}},
+                                      {^RandomDouble: {min: 0.0, max: 1.0}}]}}
+         })"},
+        {"^Join",
+         R"({
+            id: {^Join: {array: [user, {^ActorIdString: {}}, {^FastRandomString: {length: 6}}],
+                         sep: "-"}},
+            ip: {^IP: {}},
+            path: {^Join: {array: [{^Choose: {from: [usr, var, tmp]}},
+                                   {^RandomString: {length: 8}},
+                                   {^FastRandomString: {length: 8}},
+                                   file.txt],
+                           sep: "/"}}
+         })"},
+    };
+}
+
+struct Result {
+    size_t documents = 0;
+    size_t bytes = 0;
+    clock::duration elapsed{};
+};
+
+/**
+ * Generate documents from `yaml` on each of `threads` threads for kDuration.
+ * @return the totals across threads.
+ */
+Result run(const std::string& yaml, size_t threads) {
+    NodeSource ns{yaml, ""};
+    // Made up front so that a bad template fails the test rather than a thread.
+    std::vector<DefaultRandom> rngs;
+    rngs.reserve(threads);
+    std::vector<DocumentGenerator> generators;
+    for (size_t i = 0; i < threads; ++i) {
+        rngs.emplace_back(269849313357703264 + i);
+        generators.emplace_back(ns.root(), GeneratorArgs{rngs.back(), ActorId(i + 1)});
+    }
+
+    std::vector<Result> results(threads);
+    std::atomic<size_t> ready = 0;
+    std::atomic_bool go = false;
+
+    auto generate = [&](size_t index) {
+        auto& docGen = generators[index];
+        DocumentGenerator::Buffer buffer;
+
+        const auto warmupEnd = clock::now() + kWarmup;
+        while (clock::now() < warmupEnd) {
+            docGen.evaluateInto(buffer);
+        }
+
+        ++ready;
+        while (!go) {
+            std::this_thread::yield();
+        }
+        auto& result = results[index];
+        const auto end = clock::now() + kDuration;
+        while (clock::now() < end) {
+            for (int i = 0; i < kChunk; ++i) {
+                result.bytes += docGen.evaluateInto(buffer).length();
+            }
+            result.documents += kChunk;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < threads; ++i) {
+        workers.emplace_back(generate, i);
+    }
+    while (ready < threads) {
+        std::this_thread::yield();
+    }
+    const auto start = clock::now();
+    go = true;
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+    Result total;
+    total.elapsed = clock::now() - start;
+    for (auto&& result : results) {
+        total.documents += result.documents;
+        total.bytes += result.bytes;
+    }
+    return total;
+}
+
+void report(const Template& tmpl, size_t threads, std::ofstream& json) {
+    const auto result = run(tmpl.yaml, threads);
+    const auto seconds = std::chrono::duration<double>(result.elapsed).count();
+    // Time each thread spends per document, so it stays flat as threads scale perfectly.
+    const auto nanosPerDocument = seconds * 1e9 * threads / result.documents;
+    const auto bytesPerSecond = result.bytes / seconds;
+    const auto bytesPerDocument = double(result.bytes) / result.documents;
+
+    std::cout << tmpl.name << " on " << threads << " thread(s): " << nanosPerDocument
+              << " ns/document, " << bytesPerSecond / (1024 * 1024) << " MB/s, "
+              << bytesPerDocument << " bytes/document" << std::endl;
+    if (json) {
+        json << R"({"benchmark": "DocumentGenerator", "template": ")" << tmpl.name
+             << R"(", "threads": )" << threads << R"(, "documents": )" << result.documents
+             << R"(, "ns_per_document": )" << nanosPerDocument << R"(, "bytes_per_second": )"
+             << bytesPerSecond << R"(, "bytes_per_document": )" << bytesPerDocument << "}"
+             << std::endl;
+    }
+    REQUIRE(result.documents > 0);
+}
+
+}  // namespace
+
+/**
+ * Document generation throughput for templates like the ones in src/workloads, on one thread
+ * and on one per core.
+ *
+ * Each result is printed, and also appended as a line of JSON to the file named by the
+ * `GENNY_BENCHMARK_RESULTS` environment variable if it is set, so results can be tracked over
+ * time.
+ */
+TEST_CASE("DocumentGenerator throughput", "[benchmark]") {
+    std::ofstream json;
+    if (const auto path = std::getenv("GENNY_BENCHMARK_RESULTS")) {
+        json.open(path, std::ios::app);
+        REQUIRE(json);
+    }
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    for (auto&& tmpl : templates()) {
+        report(tmpl, 1, json);
+        if (cores > 1) {
+            report(tmpl, cores, json);
+        }
+    }
+}
+
+}  // namespace genny
@@ -0,0 +1,91 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <boost/random/uniform_int_distribution.hpp>
+
+#include <testlib/helpers.hpp>
+
+#include <value_generators/DefaultRandom.hpp>
+
+namespace genny {
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+constexpr int kDraws = 50'000'000;
+
+// Enough actors that their engines don't all fit in L1/L2.
+constexpr int kActors = 10'000;
+
+double millionsPerSecond(int64_t count, clock::duration elapsed) {
+    return double(count) / std::chrono::duration<double>(elapsed).count() / 1e6;
+}
+
+size_t bytesPerActor(v1::EngineType engine) {
+    const size_t heap =
+        engine == v1::EngineType::kMt19937_64 ? sizeof(boost::random::mt19937_64) : 0;
+    return sizeof(DefaultRandom) + heap;
+}
+
+void report(v1::EngineType engine, const char* name) {
+    uint64_t sink = 0;
+
+    DefaultRandom rng{engine, 269849313357703264};
+    auto start = clock::now();
+    for (int i = 0; i < kDraws; ++i) {
+        sink += rng();
+    }
+    const auto raw = millionsPerSecond(kDraws, clock::now() - start);
+
+    boost::random::uniform_int_distribution<int64_t> dist{0, 999};
+    start = clock::now();
+    for (int i = 0; i < kDraws; ++i) {
+        sink += dist(rng);
+    }
+    const auto distributed = millionsPerSecond(kDraws, clock::now() - start);
+
+    // Round-robin over many actors' engines, like a workload with many threads.
+    std::vector<DefaultRandom> actors;
+    actors.reserve(kActors);
+    for (int i = 0; i < kActors; ++i) {
+        actors.push_back(rng.child());
+    }
+    start = clock::now();
+    for (int i = 0; i < kDraws / kActors; ++i) {
+        for (auto& actor : actors) {
+            sink += actor();
+        }
+    }
+    const auto manyActors = millionsPerSecond(kDraws / kActors * kActors, clock::now() - start);
+
+    std::cout << name << ": " << raw << "M draws/s, " << distributed
+              << "M uniform_int_distribution/s, " << manyActors << "M draws/s across " << kActors
+              << " actors, " << bytesPerActor(engine) << " bytes per actor" << std::endl;
+    REQUIRE(sink != 0);
+}
+
+}  // namespace
+
+TEST_CASE("Random engine throughput", "[benchmark]") {
+    report(v1::EngineType::kMt19937_64, "mt19937_64");
+    report(v1::EngineType::kXoshiro256StarStar, "xoshiro256**");
+    report(v1::EngineType::kPcg64, "pcg64");
+    report(v1::EngineType::kPhilox4x64, "philox4x64");
+}
+
+}  // namespace genny
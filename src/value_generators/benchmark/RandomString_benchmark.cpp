@@ -0,0 +1,91 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <gennylib/Node.hpp>
+
+#include <testlib/helpers.hpp>
+
+#include <value_generators/DefaultRandom.hpp>
+#include <value_generators/DocumentGenerator.hpp>
+#include <value_generators/v1/RandomString.hpp>
+
+namespace genny {
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+constexpr size_t kLength = 1024;
+constexpr int kIterations = 100000;
+
+double megabytesPerSecond(clock::duration elapsed) {
+    const auto seconds = std::chrono::duration<double>(elapsed).count();
+    return double(kLength) * kIterations / seconds / (1024 * 1024);
+}
+
+void reportGenerator(const std::string& name, const std::string& options = "") {
+    NodeSource ns{"a: {" + name + ": {length: " + std::to_string(kLength) + options + "}}", ""};
+    DefaultRandom rng;
+    DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1}};
+    DocumentGenerator::Buffer buffer;
+
+    size_t bytes = 0;
+    const auto start = clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        bytes += docGen.evaluateInto(buffer).length();
+    }
+    const auto elapsed = clock::now() - start;
+
+    std::cout << name << options << " of " << kLength
+              << " characters: " << megabytesPerSecond(elapsed)
+              << " MB/s" << std::endl;
+    REQUIRE(bytes > kLength * kIterations);
+}
+
+void reportKernel(v1::RandomStringKernel::Isa isa, const char* isaName) {
+    if (!v1::RandomStringKernel::supported(isa)) {
+        std::cout << "RandomStringKernel " << isaName << ": not supported" << std::endl;
+        return;
+    }
+    v1::RandomStringKernel kernel{
+        "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789+/", isa};
+    std::string str(kLength, '\0');
+
+    const auto start = clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        kernel.fill(str.data(), str.size(), i);
+    }
+    const auto elapsed = clock::now() - start;
+
+    std::cout << "RandomStringKernel " << isaName << ": " << megabytesPerSecond(elapsed)
+              << " MB/s" << std::endl;
+    REQUIRE(str.find('\0') == std::string::npos);
+}
+
+}  // namespace
+
+TEST_CASE("Random string throughput", "[benchmark]") {
+    reportGenerator("^RandomString");
+    reportGenerator("^FastRandomString");
+    reportGenerator("^CompressibleString", ", ratio: 0.4");
+
+    reportKernel(v1::RandomStringKernel::Isa::kScalar, "scalar");
+    reportKernel(v1::RandomStringKernel::Isa::kSse4, "sse4.1");
+    reportKernel(v1::RandomStringKernel::Isa::kAvx2, "avx2");
+}
+
+}  // namespace genny
@@ -0,0 +1,53 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HEADER_3CC1D187_C605_4304_A22B_28C51BD4A941_INCLUDED
+#define HEADER_3CC1D187_C605_4304_A22B_28C51BD4A941_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace genny {
+
+/**
+ * @return the weights of weightedChoice(size): 1, 2, ..., 7, 1, 2, ...
+ */
+inline std::vector<int64_t> choiceWeights(size_t size) {
+    std::vector<int64_t> weights;
+    for (size_t i = 0; i < size; ++i) {
+        weights.push_back(int64_t(i % 7 + 1));
+    }
+    return weights;
+}
+
+/**
+ * @return `{^Choose: {from: [word0, word1, ...], weights: [1, 2, ...]}}` with `size` words.
+ */
+inline std::string weightedChoice(size_t size) {
+    const auto weights = choiceWeights(size);
+    std::ostringstream from;
+    std::ostringstream weightList;
+    for (size_t i = 0; i < size; ++i) {
+        from << (i ? ", " : "") << "word" << i;
+        weightList << (i ? ", " : "") << weights[i];
+    }
+    return "{^Choose: {from: [" + from.str() + "], weights: [" + weightList.str() + "]}}";
+}
+
+}  // namespace genny
+
+#endif  // HEADER_3CC1D187_C605_4304_A22B_28C51BD4A941_INCLUDED
@@ -17,9 +17,12 @@
 
 #include <cstdint>
 #include <memory>
+#include <type_traits>
 
 #include <boost/random.hpp>
 
+#include <value_generators/v1/RandomEngines.hpp>
+
 namespace genny {
 namespace v1 {
 
@@ -44,6 +47,11 @@ public:
      */
     explicit Random(result_type seed = 6514393) : _rng(seed) {}
 
+    /**
+     * Construct a Random object using the given engine. Only for `Random<AnyEngine>`.
+     */
+    Random(EngineType type, result_type seed) : _rng(type, seed) {}
+
     // Moves are okay
     Random(Random&&) noexcept = default;
     Random& operator=(Random&&) noexcept = default;
@@ -59,7 +67,18 @@ public:
      * @return
      */
     Random child() {
-        return Random(this->nextValue());
+        if constexpr (std::is_same_v<RNGImpl, AnyEngine>) {
+            return Random(this->engineType(), this->nextValue());
+        } else {
+            return Random(this->nextValue());
+        }
+    }
+
+    /**
+     * The engine in use. Only for `Random<AnyEngine>`.
+     */
+    EngineType engineType() const {
+        return _rng.type();
     }
 
     /**
@@ -106,10 +125,12 @@ private:
 
 /**
  * DefaultRandom should be used if you need a random number generator.
+ *
+ * It uses mt19937_64 unless the workload picks another engine with `RandomEngine:`.
  */
 // Note we use boost::random because its distributions are
 // cross-platform.
-using DefaultRandom = v1::Random<boost::random::mt19937_64>;
+using DefaultRandom = v1::Random<v1::AnyEngine>;
 
 }  // namespace genny
 #endif  // HEADER_EBA231D0_AA7A_4008_A9E8_BD1C98D9023E_INCLUDED
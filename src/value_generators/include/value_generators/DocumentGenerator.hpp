@@ -15,11 +15,15 @@
 #ifndef HEADER_E6E05F14_BE21_4A9B_822D_FFD669CFB1B4_INCLUDED
 #define HEADER_E6E05F14_BE21_4A9B_822D_FFD669CFB1B4_INCLUDED
 
+#include <cstdint>
 #include <exception>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
 
 #include <gennylib/Node.hpp>
 #include <gennylib/context.hpp>
@@ -52,17 +56,66 @@ public:
     using InvalidValueGeneratorSyntax::InvalidValueGeneratorSyntax;
 };
 
+/**
+ * Which of the `Threads` of its Actor block an actor is. `^Inc: {scope: partitioned}` gives
+ * each one its own part of the values.
+ *
+ * With `genny run --workers N` it also has the worker processes' group, so that generators
+ * which hand out values across actors share them between workers too.
+ */
+struct ActorThread {
+    size_t index = 0;
+    size_t count = 1;
+    v1::WorkerGroup* workerGroup = nullptr;
+
+    /**
+     * @return where the actor with `id` sits in `actorContext`'s block, or the only thread if
+     * it isn't one of the block's actors.
+     */
+    static ActorThread of(const ActorContext& actorContext, ActorId id);
+};
+
 struct GeneratorArgs {
     DefaultRandom& rng;
     ActorId actorId;
+    ActorThread thread = {};
 };
 
 
 class DocumentGenerator {
 public:
+    /**
+     * Seeds each document on its own rather than drawing from one random stream, as workloads
+     * with `RandomSeeding: counter` do.
+     *
+     * Document `i` is generated from an engine seeded with a hash of `seed`, the actor id,
+     * `phase`, the template, where the template is in the workload, and `i`. It is therefore
+     * the same however many documents came before it and whichever thread generated them.
+     * Values are drawn in field order, so each one is a pure function of those and its field.
+     *
+     * Generators that count rather than draw, like `^Inc` or a sequential `^FromFile`, still
+     * count per generator.
+     */
+    struct CounterSeed {
+        uint64_t seed;
+        uint64_t phase;
+        v1::EngineType engine;
+
+        // The phase of templates that are used by every phase of an Actor.
+        static constexpr uint64_t kEveryPhase = ~uint64_t{0};
+    };
+
+    /**
+     * Seeded by counter if the workload has `RandomSeeding: counter`, otherwise drawing from
+     * the Actor's DefaultRandom.
+     */
     explicit DocumentGenerator(const Node& node, PhaseContext& phaseContext, ActorId id);
     explicit DocumentGenerator(const Node& node, ActorContext& phaseContext, ActorId id);
     explicit DocumentGenerator(const Node& node, GeneratorArgs generatorArgs);
+    explicit DocumentGenerator(const Node& node,
+                               ActorId id,
+                               CounterSeed counterSeed,
+                               ActorThread thread = {});
     /**
      * @return a document according to the template given by the node in the constructor.
      */
@@ -84,11 +137,120 @@ public:
      * @return
      */
     bsoncxx::document::value evaluate();
+
+    /**
+     * Caller-owned storage for evaluateInto(). It grows to fit the largest document generated
+     * into it and never shrinks, so reusing one doesn't allocate once it has warmed up.
+     */
+    class Buffer {
+    public:
+        Buffer() = default;
+        explicit Buffer(size_t capacity) {
+            _bytes.reserve(capacity);
+        }
+
+    private:
+        friend class DocumentGenerator;
+        std::vector<uint8_t> _bytes;
+    };
+
+    /**
+     * Like `evaluate()` but writes the document into `buffer` instead of a new allocation.
+     *
+     * ```c++
+     * DocumentGenerator::Buffer buffer;
+     * while (...) {
+     *     collection.insert_one(docGen.evaluateInto(buffer));
+     * }
+     * ```
+     *
+     * @return a view of the document. It is only valid until `buffer` is next written to or
+     * destroyed. Documents that already exist whole, like those of a top-level `^FromFile`,
+     * aren't copied into `buffer`; their views stay valid for as long as this generator does.
+     */
+    bsoncxx::document::view evaluateInto(Buffer& buffer);
+
+    /**
+     * Caller-owned storage for many documents stored back-to-back, e.g. one `insert_many`
+     * batch. Like Buffer it keeps its capacity when cleared so it can be reused across
+     * batches.
+     */
+    class Arena {
+    public:
+        Arena() = default;
+        explicit Arena(size_t capacity) {
+            _bytes.reserve(capacity);
+        }
+
+        /**
+         * Forget all documents but keep the memory.
+         */
+        void clear() {
+            _bytes.clear();
+            _offsets.clear();
+        }
+
+        size_t size() const {
+            return _offsets.size();
+        }
+
+        /**
+         * @return a view of each document in the order they were added. These are only
+         * valid until the arena is next written to or destroyed.
+         */
+        const std::vector<bsoncxx::document::view>& views();
+
+    private:
+        friend class DocumentGenerator;
+        std::vector<uint8_t> _bytes;
+        std::vector<size_t> _offsets;
+        std::vector<bsoncxx::document::view> _views;
+    };
+
+    /**
+     * Generate the next document onto the end of `arena`.
+     */
+    void appendTo(Arena& arena);
+
+    /**
+     * Replace the contents of `arena` with the next `n` documents.
+     *
+     * ```c++
+     * DocumentGenerator::Arena arena;
+     * while (...) {
+     *     collection.insert_many(docGen.generateBatch(batchSize, arena));
+     * }
+     * ```
+     *
+     * @param firstId
+     *   if set, each document starts with an int32 `_id` field, counting up from this value.
+     * @return the documents' views, as from `arena.views()`.
+     */
+    const std::vector<bsoncxx::document::view>& generateBatch(
+        size_t n, Arena& arena, std::optional<int32_t> firstId = std::nullopt);
+
+    /**
+     * Make the next document generated document `iteration`, e.g. to regenerate one that was
+     * sent earlier and check it. Only for generators seeded by counter.
+     *
+     * @throws std::logic_error if this generator isn't seeded by counter.
+     */
+    void seek(uint64_t iteration);
+
     DocumentGenerator(DocumentGenerator&&) noexcept;
     ~DocumentGenerator();
     class Impl;
 
 private:
+    struct Counter;
+
+    /**
+     * Seed the engine for the next document if seeded by counter.
+     */
+    void nextDocument();
+
+    // Declared before _impl, whose generators keep a reference to its engine.
+    std::unique_ptr<Counter> _counter;
     std::unique_ptr<Impl> _impl;
 };
 
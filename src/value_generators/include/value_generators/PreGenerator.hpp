@@ -0,0 +1,222 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HEADER_2280FF3E_2EA3_42AE_B277_4305F1A6DA0B_INCLUDED
+#define HEADER_2280FF3E_2EA3_42AE_B277_4305F1A6DA0B_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <bsoncxx/document/view.hpp>
+
+#include <gennylib/Node.hpp>
+
+#include <value_generators/DefaultRandom.hpp>
+#include <value_generators/DocumentGenerator.hpp>
+
+namespace genny {
+
+/**
+ * Generates documents ahead of time on helper threads, so the threads that send them only
+ * have to pick up the next ready one.
+ *
+ * Each Stream has its own DocumentGenerator and random generator, and only ever runs on one
+ * helper thread. A stream therefore produces exactly the same documents in the same order as
+ * evaluating its generator inline with the same seed would, whatever the number of threads.
+ *
+ * That only holds while a template reads nothing that other generators change. A
+ * `{^RandomInt: {distribution: latest, inc: <name>}}` whose named ^Inc is in another template
+ * sees however far that template's stream has got, which depends on thread timing. So does an
+ * `{^Inc: {scope: workload}}`, though that isn't reproducible inline either.
+ *
+ * Nothing is generated for a stream until its first `next()`. A stream whose consumer never
+ * runs, like one for an actor that another `genny run --workers` process runs, costs no helper
+ * time and draws nothing from counters it shares with other generators. Helper threads are also
+ * only started by the first `next()` of one of their streams, so they inherit the cpu placement
+ * of the consumer's thread rather than that of the thread that created the stream.
+ *
+ * ```c++
+ * PreGenerator preGenerator{2, 1024};
+ * auto stream = preGenerator.stream(node["Document"], rng.child(), id);
+ * while (...) {
+ *     collection.insert_one(stream->next());
+ * }
+ * ```
+ */
+class PreGenerator {
+public:
+    class Stream;
+
+    /**
+     * @param threads how many helper threads fill the streams. Must be positive.
+     * @param depth how many documents each stream keeps ready. Must be positive.
+     */
+    PreGenerator(size_t threads, size_t depth);
+
+    /**
+     * Stops and joins the helper threads. Streams stop being filled, so consumers should keep
+     * the PreGenerator alive for as long as they call `Stream::next()`.
+     */
+    ~PreGenerator();
+
+    PreGenerator(const PreGenerator&) = delete;
+    PreGenerator& operator=(const PreGenerator&) = delete;
+
+    /**
+     * Add a stream of documents from `node`. Streams are spread round-robin over the helper
+     * threads.
+     *
+     * @param rng seeds the stream's documents. It belongs to the stream from now on, so pass
+     * e.g. a `child()` of the actor's generator rather than the generator itself.
+     * @param thread where the consuming actor sits in its Actor block.
+     * @throws InvalidValueGeneratorSyntax if `node` isn't a valid template.
+     */
+    std::shared_ptr<Stream> stream(const Node& node,
+                                   DefaultRandom rng,
+                                   ActorId id,
+                                   ActorThread thread = {});
+
+    /**
+     * Add a stream of documents from `node`, seeded by counter. The stream produces the same
+     * documents as a DocumentGenerator constructed with the same arguments.
+     *
+     * @throws InvalidValueGeneratorSyntax if `node` isn't a valid template.
+     */
+    std::shared_ptr<Stream> stream(const Node& node,
+                                   ActorId id,
+                                   DocumentGenerator::CounterSeed counterSeed,
+                                   ActorThread thread = {});
+
+    size_t depth() const {
+        return _depth;
+    }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<Stream>> streams;
+        // Started by the first consumer of one of the streams. See start().
+        std::once_flag started;
+        std::thread thread;
+
+        // Lets a consumer that ran out of documents cut the helper's idle sleep short.
+        std::mutex idleMutex;
+        std::condition_variable idle;
+        bool woken = false;
+
+        void wake();
+    };
+
+    std::shared_ptr<Stream> add(std::shared_ptr<Stream> stream);
+
+    /**
+     * Start `worker`'s thread if it isn't running yet.
+     */
+    void start(Worker& worker);
+
+    void work(Worker& worker);
+
+    const size_t _depth;
+    std::vector<std::unique_ptr<Worker>> _workers;
+    size_t _nextWorker = 0;
+    std::atomic_bool _stop = false;
+};
+
+/**
+ * Documents from one template, for one consumer thread.
+ *
+ * This is a single-producer single-consumer ring of `depth` document buffers. The helper
+ * thread writes into free slots and publishes them; the consumer reads the oldest one and
+ * hands its slot back on its next call.
+ */
+class PreGenerator::Stream {
+public:
+    Stream(const Node& node, DefaultRandom rng, ActorId id, ActorThread thread, size_t depth);
+    Stream(const Node& node,
+           ActorId id,
+           DocumentGenerator::CounterSeed counterSeed,
+           ActorThread thread,
+           size_t depth);
+
+    /**
+     * Waits for a document if none is ready yet. The wait blocks the thread, or inside a
+     * v1::ActorScheduler lets other actors run.
+     *
+     * @return the next document. It is only valid until the next call.
+     * @throws whatever generating the document threw, once the documents generated before the
+     * failure have been consumed.
+     */
+    bsoncxx::document::view next();
+
+private:
+    friend class PreGenerator;
+
+    /**
+     * Fill up to `max` free slots. Only called by the stream's helper thread.
+     * @return how many were filled.
+     */
+    size_t fill(size_t max);
+
+    /**
+     * Wait until document `head` is published or the generator has failed.
+     */
+    void await(size_t head);
+
+    /**
+     * Wake the consumer if it is blocked in await(). Only called by the helper thread.
+     */
+    void publish();
+
+    // Declared before _generator, which keeps a reference to it.
+    DefaultRandom _rng;
+    DocumentGenerator _generator;
+
+    std::vector<DocumentGenerator::Buffer> _buffers;
+    std::vector<bsoncxx::document::view> _views;
+
+    // Monotonic counts of documents consumed and published. Slot `i % depth` holds document
+    // `i`. Each is on its own cache line so producer and consumer don't contend.
+    alignas(64) std::atomic<size_t> _head = 0;
+    alignas(64) std::atomic<size_t> _tail = 0;
+
+    // Set by the helper thread, with _failed, if the generator threw.
+    std::exception_ptr _error;
+    std::atomic_bool _failed = false;
+
+    // Whether the consumer still holds slot `_head` from its last call to next().
+    bool _holding = false;
+
+    // The PreGenerator and helper thread that fill this stream. Set by PreGenerator::add().
+    PreGenerator* _preGenerator = nullptr;
+    Worker* _worker = nullptr;
+
+    // Set by the consumer's first call to next(). The helper leaves the stream alone until then.
+    std::atomic_bool _started = false;
+
+    // For a consumer blocked in await(). `_waiting` is only set while it waits, so the helper
+    // doesn't touch the mutex otherwise.
+    std::mutex _mutex;
+    std::condition_variable _ready;
+    std::atomic_bool _waiting = false;
+};
+
+}  // namespace genny
+
+#endif  // HEADER_2280FF3E_2EA3_42AE_B277_4305F1A6DA0B_INCLUDED
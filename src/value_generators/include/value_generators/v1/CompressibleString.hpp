@@ -0,0 +1,61 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HEADER_097DCD79_5D43_4DFF_8B41_B6B270DD48D4_INCLUDED
+#define HEADER_097DCD79_5D43_4DFF_8B41_B6B270DD48D4_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+
+namespace genny::v1 {
+
+/**
+ * Fills strings that compress to about `ratio` of their size. This is the kernel behind
+ * `^CompressibleString`.
+ *
+ * Like fio's `buffer_compress_percentage`, every 256-byte segment starts with a run of random
+ * bytes and ends with a run of one repeated character. Strings have to be valid UTF-8, so the
+ * random bytes are 7-bit ASCII (never NUL), which DEFLATE-style compressors still squeeze to
+ * about 7/8 of their size. The length of the random run is calibrated against zlib at its
+ * default level. zstd lands close to that; snappy has no entropy coding so compresses a
+ * little less. Ratios above about 0.88 just give fully random strings.
+ *
+ * @private
+ */
+class CompressibleStringKernel {
+public:
+    /**
+     * @param ratio compressed size over original size, in [0, 1].
+     */
+    explicit CompressibleStringKernel(double ratio);
+
+    /**
+     * Overwrite `out[0, length)`.
+     */
+    void fill(char* out, size_t length, uint64_t seed) const;
+
+    /**
+     * @return how many bytes of each 256-byte segment are random.
+     */
+    size_t randomPerSegment() const {
+        return _randomPerSegment;
+    }
+
+private:
+    size_t _randomPerSegment;
+};
+
+}  // namespace genny::v1
+
+#endif  // HEADER_097DCD79_5D43_4DFF_8B41_B6B270DD48D4_INCLUDED
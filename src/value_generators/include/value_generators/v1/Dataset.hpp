@@ -0,0 +1,120 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HEADER_696AFE9A_A590_4C06_B291_DEB657FEE6B0_INCLUDED
+#define HEADER_696AFE9A_A590_4C06_B291_DEB657FEE6B0_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/types.hpp>
+
+namespace genny::v1 {
+
+/**
+ * The documents in a file, loaded once and shared by every `^FromFile` that reads it.
+ *
+ * BSON files (documents back to back, as mongodump writes them) are memory-mapped rather than
+ * read, so the documents handed out point straight into the page cache. Files ending in
+ * `.json`, `.jsonl` or `.ndjson` hold one extended-JSON document per line and are converted to
+ * BSON when they're loaded.
+ *
+ * Either way an index of where each document starts is built up front, so picking the i-th
+ * document is an array lookup.
+ *
+ * @private
+ */
+class Dataset {
+public:
+    /**
+     * @throws std::invalid_argument if the file can't be read, has no documents, or isn't a
+     * well-formed sequence of documents.
+     */
+    explicit Dataset(const std::string& path);
+    ~Dataset();
+
+    Dataset(const Dataset&) = delete;
+    Dataset& operator=(const Dataset&) = delete;
+
+    size_t size() const {
+        return _offsets.size();
+    }
+
+    /**
+     * @return document `i`. It is valid for as long as this Dataset is.
+     */
+    bsoncxx::document::view operator[](size_t i) const {
+        const auto offset = _offsets[i];
+        const auto end = i + 1 < _offsets.size() ? _offsets[i + 1] : _length;
+        return bsoncxx::document::view{_data + offset, end - offset};
+    }
+
+    /**
+     * @return the index of the next document in file order. The position is shared by every
+     * caller, so between them concurrent readers see each document once per pass over the file.
+     */
+    size_t nextSequential() {
+        return size_t(_cursor.fetch_add(1, std::memory_order_relaxed) % _offsets.size());
+    }
+
+    /**
+     * Like nextSequential() but counting with `cursor`, e.g. one shared by several worker
+     * processes that each have their own copy of this Dataset.
+     */
+    size_t nextSequential(std::atomic_int64_t& cursor) const {
+        return size_t(uint64_t(cursor.fetch_add(1, std::memory_order_relaxed)) % _offsets.size());
+    }
+
+private:
+    void index(const std::string& path);
+
+    const uint8_t* _data = nullptr;
+    size_t _length = 0;
+    // Set if _data is a mapping of the file rather than pointing into _converted.
+    bool _mapped = false;
+    std::vector<uint8_t> _converted;
+    std::vector<size_t> _offsets;
+    std::atomic<uint64_t> _cursor = 0;
+};
+
+/**
+ * A BSON value inside some document, without its key.
+ *
+ * @private
+ */
+struct RawValue {
+    bsoncxx::type type;
+    const uint8_t* data;
+    size_t size;
+};
+
+/**
+ * @param path the keys to follow through nested documents and arrays, e.g. `{"address",
+ * "city"}` or `{"tags", "0"}`.
+ * @return the value at `path`, or nullopt if there isn't one.
+ * @throws std::invalid_argument if `doc` is malformed.
+ *
+ * @private
+ */
+std::optional<RawValue> findValue(bsoncxx::document::view doc,
+                                  const std::vector<std::string>& path);
+
+}  // namespace genny::v1
+
+#endif  // HEADER_696AFE9A_A590_4C06_B291_DEB657FEE6B0_INCLUDED
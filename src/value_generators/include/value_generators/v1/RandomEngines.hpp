@@ -0,0 +1,366 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HEADER_6F0C2E4B_93A1_4D55_B0E2_7A8C1F35D9B6_INCLUDED
+#define HEADER_6F0C2E4B_93A1_4D55_B0E2_7A8C1F35D9B6_INCLUDED
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <variant>
+
+#include <boost/random/mersenne_twister.hpp>
+
+namespace genny::v1 {
+
+/**
+ * xoshiro256** by Blackman and Vigna, seeded with SplitMix64 as its authors recommend.
+ * 32 bytes of state. See https://prng.di.unimi.it.
+ *
+ * @private
+ */
+class Xoshiro256StarStar {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256StarStar(uint64_t seed = 0) {
+        this->seed(seed);
+    }
+
+    void seed(uint64_t seed) {
+        for (auto& word : _s) {
+            seed += 0x9e3779b97f4a7c15;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    result_type operator()() {
+        const uint64_t result = rotl(_s[1] * 5, 7) * 9;
+        const uint64_t t = _s[1] << 17;
+        _s[2] ^= _s[0];
+        _s[3] ^= _s[1];
+        _s[1] ^= _s[2];
+        _s[0] ^= _s[3];
+        _s[2] ^= t;
+        _s[3] = rotl(_s[3], 45);
+        return result;
+    }
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t _s[4];
+};
+
+/**
+ * PCG64 (XSL RR 128/64) by O'Neill, seeded the way the reference `pcg64` is.
+ * 16 bytes of state. See https://www.pcg-random.org.
+ *
+ * @private
+ */
+class Pcg64 {
+public:
+    using result_type = uint64_t;
+
+    explicit Pcg64(uint64_t seed = 0) {
+        this->seed(seed);
+    }
+
+    void seed(uint64_t seed) {
+        _state = 0;
+        step();
+        _state += seed;
+        step();
+    }
+
+    result_type operator()() {
+        const auto old = _state;
+        step();
+        const auto xored = static_cast<uint64_t>(old >> 64) ^ static_cast<uint64_t>(old);
+        const auto rot = static_cast<int>(old >> 122);
+        return (xored >> rot) | (xored << ((-rot) & 63));
+    }
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+private:
+    using uint128 = unsigned __int128;
+
+    static constexpr uint128 kMultiplier =
+        (uint128{2549297995355413924ULL} << 64) + 4865540595714422341ULL;
+    static constexpr uint128 kIncrement =
+        (uint128{6364136223846793005ULL} << 64) + 1442695040888963407ULL;
+
+    void step() {
+        _state = _state * kMultiplier + kIncrement;
+    }
+
+    uint128 _state;
+};
+
+/**
+ * Philox4x64-10 by Salmon et al. ("Parallel Random Numbers: As Easy as 1, 2, 3", SC 2011).
+ * Counter-based: the seed is the key and each block of four outputs is a pure function of
+ * the key and a counter, so streams can't overlap no matter how they are seeded.
+ *
+ * @private
+ */
+class Philox4x64 {
+public:
+    using result_type = uint64_t;
+
+    explicit Philox4x64(uint64_t seed = 0) {
+        this->seed(seed);
+    }
+
+    void seed(uint64_t seed) {
+        _key[0] = seed;
+        _key[1] = 0;
+        _counter[0] = _counter[1] = _counter[2] = _counter[3] = 0;
+        _next = 4;
+    }
+
+    result_type operator()() {
+        if (_next == 4) {
+            refill();
+        }
+        return _block[_next++];
+    }
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+private:
+    using uint128 = unsigned __int128;
+
+    void refill() {
+        uint64_t x[4] = {_counter[0], _counter[1], _counter[2], _counter[3]};
+        uint64_t k[2] = {_key[0], _key[1]};
+        for (int round = 0; round < 10; ++round) {
+            const auto p0 = uint128{0xD2E7470EE14C6C93ULL} * x[0];
+            const auto p1 = uint128{0xCA5A826395121157ULL} * x[2];
+            const auto hi0 = static_cast<uint64_t>(p0 >> 64);
+            const auto hi1 = static_cast<uint64_t>(p1 >> 64);
+            x[0] = hi1 ^ x[1] ^ k[0];
+            x[1] = static_cast<uint64_t>(p1);
+            x[2] = hi0 ^ x[3] ^ k[1];
+            x[3] = static_cast<uint64_t>(p0);
+            k[0] += 0x9E3779B97F4A7C15ULL;
+            k[1] += 0xBB67AE8584CAA73BULL;
+        }
+        for (int i = 0; i < 4; ++i) {
+            _block[i] = x[i];
+        }
+        // Carry through the 256-bit counter.
+        for (auto& word : _counter) {
+            if (++word != 0) {
+                break;
+            }
+        }
+        _next = 0;
+    }
+
+    uint64_t _key[2];
+    uint64_t _counter[4];
+    uint64_t _block[4];
+    uint8_t _next;
+};
+
+/**
+ * @return a seed that is a pure function of `seed` and `value`. Chain calls to derive a seed
+ * from several values, e.g. `mixSeed(mixSeed(seed, actorId), iteration)`. The result goes
+ * through SplitMix64's finalizer so that neighbouring inputs give unrelated seeds.
+ *
+ * @private
+ */
+constexpr uint64_t mixSeed(uint64_t seed, uint64_t value) {
+    uint64_t z = seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+/**
+ * The engines a workload can pick with `RandomEngine:`.
+ */
+enum class EngineType {
+    kMt19937_64,
+    kXoshiro256StarStar,
+    kPcg64,
+    kPhilox4x64,
+};
+
+/**
+ * @param name one of `mt19937_64` (the default), `xoshiro256**`, `pcg64` or `philox4x64`.
+ * @throws std::invalid_argument for any other name.
+ */
+inline EngineType parseEngineType(const std::string& name) {
+    if (name == "mt19937_64") {
+        return EngineType::kMt19937_64;
+    }
+    if (name == "xoshiro256**") {
+        return EngineType::kXoshiro256StarStar;
+    }
+    if (name == "pcg64") {
+        return EngineType::kPcg64;
+    }
+    if (name == "philox4x64") {
+        return EngineType::kPhilox4x64;
+    }
+    throw std::invalid_argument("Unknown RandomEngine '" + name +
+                                "'. Need one of mt19937_64/xoshiro256**/pcg64/philox4x64");
+}
+
+/**
+ * boost::random::mt19937_64 with its 2.5KB of state on the heap, allocated on first use. A
+ * default-constructed DefaultRandom that is replaced before it is used, like Pacer's, never
+ * allocates.
+ *
+ * @private
+ */
+class LazyMt19937_64 {
+public:
+    using result_type = uint64_t;
+
+    explicit LazyMt19937_64(uint64_t seed = 0) : _seed{seed} {}
+
+    void seed(uint64_t seed) {
+        if (_engine) {
+            _engine->seed(seed);
+        } else {
+            _seed = seed;
+        }
+    }
+
+    result_type operator()() {
+        if (!_engine) {
+            _engine = std::make_unique<boost::random::mt19937_64>(_seed);
+        }
+        return (*_engine)();
+    }
+
+private:
+    std::unique_ptr<boost::random::mt19937_64> _engine;
+    uint64_t _seed;
+};
+
+/**
+ * One of the engines above, picked at runtime. Every engine produces full 64-bit values so
+ * boost distributions give the same results through this as through the engine itself.
+ *
+ * mt19937_64 keeps its state on the heap so the other engines don't pay for it. See
+ * LazyMt19937_64.
+ *
+ * @private
+ */
+class AnyEngine {
+public:
+    using result_type = uint64_t;
+
+    explicit AnyEngine(uint64_t seed = 0) : AnyEngine{EngineType::kMt19937_64, seed} {}
+
+    AnyEngine(EngineType type, uint64_t seed) {
+        switch (type) {
+            case EngineType::kMt19937_64:
+                _engine = LazyMt19937_64{seed};
+                break;
+            case EngineType::kXoshiro256StarStar:
+                _engine = Xoshiro256StarStar{seed};
+                break;
+            case EngineType::kPcg64:
+                _engine = Pcg64{seed};
+                break;
+            case EngineType::kPhilox4x64:
+                _engine = Philox4x64{seed};
+                break;
+        }
+    }
+
+    EngineType type() const {
+        return static_cast<EngineType>(_engine.index());
+    }
+
+    void seed(uint64_t seed) {
+        switch (_engine.index()) {
+            case 0:
+                std::get_if<0>(&_engine)->seed(seed);
+                break;
+            case 1:
+                std::get_if<1>(&_engine)->seed(seed);
+                break;
+            case 2:
+                std::get_if<2>(&_engine)->seed(seed);
+                break;
+            default:
+                std::get_if<3>(&_engine)->seed(seed);
+                break;
+        }
+    }
+
+    result_type operator()() {
+        // A switch rather than std::visit so the common case is a predictable branch.
+        switch (_engine.index()) {
+            case 0:
+                return (*std::get_if<0>(&_engine))();
+            case 1:
+                return (*std::get_if<1>(&_engine))();
+            case 2:
+                return (*std::get_if<2>(&_engine))();
+            default:
+                return (*std::get_if<3>(&_engine))();
+        }
+    }
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+private:
+    // Alternatives are in EngineType order.
+    std::variant<LazyMt19937_64, Xoshiro256StarStar, Pcg64, Philox4x64> _engine;
+};
+
+}  // namespace genny::v1
+
+#endif  // HEADER_6F0C2E4B_93A1_4D55_B0E2_7A8C1F35D9B6_INCLUDED
@@ -0,0 +1,86 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HEADER_1DEB23A2_4C0F_4A63_873B_CE48C700B934_INCLUDED
+#define HEADER_1DEB23A2_4C0F_4A63_873B_CE48C700B934_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace genny::v1 {
+
+/**
+ * Fills strings with characters drawn uniformly and independently from an alphabet.
+ * This is the kernel behind `^FastRandomString`.
+ *
+ * Random bytes come from a xoshiro256** stream seeded by the caller, so each string only
+ * costs the caller one draw from its own generator. How the bytes become characters depends
+ * on the alphabet's size `n`:
+ *
+ * - `n` a power of two up to 64, e.g. the default alphabet: each byte's low 6 bits index a
+ *   64-entry table that repeats the alphabet. There is no bias and no rejection, so this is
+ *   vectorized with AVX2 (32 characters per step) or SSE4.1 (16), picked at runtime.
+ * - Other `n` up to 256: bytes at or above the largest multiple of `n` are rejected and the
+ *   rest are taken mod `n`.
+ * - Larger `n`: Lemire's unbiased multiply-shift on 32-bit draws.
+ *
+ * Every instruction set produces exactly the same characters for the same seed.
+ *
+ * @private
+ */
+class RandomStringKernel {
+public:
+    enum class Isa { kScalar, kSse4, kAvx2 };
+
+    /**
+     * @param alphabet must not be empty.
+     * @param isa force an instruction set, for testing. Defaults to the best supported one.
+     */
+    explicit RandomStringKernel(std::string alphabet, std::optional<Isa> isa = std::nullopt);
+
+    /**
+     * @return if this CPU can run `isa`.
+     */
+    static bool supported(Isa isa);
+
+    Isa isa() const {
+        return _isa;
+    }
+
+    /**
+     * Overwrite `out[0, length)` with random characters.
+     */
+    void fill(char* out, size_t length, uint64_t seed) const;
+
+private:
+    enum class Mode { kMasked, kRejection, kWide };
+
+    std::string _alphabet;
+    Mode _mode;
+    Isa _isa;
+
+    // kMasked: the alphabet repeated to 64 entries.
+    std::array<uint8_t, 64> _masked;
+
+    // kRejection: the character for each byte and whether that byte is accepted.
+    std::array<char, 256> _byteToChar;
+    std::array<uint8_t, 256> _accepted;
+};
+
+}  // namespace genny::v1
+
+#endif  // HEADER_1DEB23A2_4C0F_4A63_873B_CE48C700B934_INCLUDED
@@ -0,0 +1,91 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HEADER_3B7E9A51_0C2D_4F86_A1E4_52D9C8B06F73_INCLUDED
+#define HEADER_3B7E9A51_0C2D_4F86_A1E4_52D9C8B06F73_INCLUDED
+
+#include <cstdint>
+
+#include <boost/random/uniform_01.hpp>
+
+namespace genny::v1 {
+
+/**
+ * The generalized harmonic number `sum(i^-theta for i in [1, n])`.
+ *
+ * The first terms are summed exactly and the tail uses the Euler-Maclaurin formula, so this
+ * is O(1) even for billions of items and accurate to about 1e-12.
+ *
+ * @private
+ */
+double zeta(uint64_t n, double theta);
+
+/**
+ * Zipfian ranks in `[0, items)`, rank 0 the most likely, as in YCSB's ZipfianGenerator
+ * (Gray et al., "Quickly Generating Billion-Record Synthetic Databases", SIGMOD 1994).
+ * All of the set-up happens in the constructor and each draw is O(1).
+ *
+ * @private
+ */
+class ZipfianDistribution {
+public:
+    /**
+     * @param items must be positive.
+     * @param theta the skew, in (0, 1). YCSB uses 0.99.
+     */
+    ZipfianDistribution(uint64_t items, double theta);
+
+    template <typename Rng>
+    uint64_t operator()(Rng& rng) const {
+        return sample(boost::random::uniform_01<double>{}(rng));
+    }
+
+    /**
+     * @param u uniform in [0, 1).
+     */
+    uint64_t sample(double u) const;
+
+    /**
+     * Extend the range to `[0, items)`. Costs O(new items) when growing by a few items at a
+     * time, as `latest` does, and O(1) otherwise. Shrinking is ignored.
+     */
+    void grow(uint64_t items);
+
+    uint64_t items() const {
+        return _items;
+    }
+
+private:
+    void computeEta();
+
+    uint64_t _items;
+    double _theta;
+    double _alpha;
+    double _zetan;
+    double _zeta2;
+    double _eta;
+    double _halfPowTheta;
+};
+
+/**
+ * FNV-1a of the value's 8 bytes. `scrambled_zipfian` uses this to spread popular ranks across
+ * the key space like YCSB.
+ *
+ * @private
+ */
+uint64_t fnv1a64(uint64_t value);
+
+}  // namespace genny::v1
+
+#endif  // HEADER_3B7E9A51_0C2D_4F86_A1E4_52D9C8B06F73_INCLUDED
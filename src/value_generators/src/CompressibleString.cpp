@@ -0,0 +1,85 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <value_generators/v1/CompressibleString.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include <boost/throw_exception.hpp>
+
+#include <value_generators/v1/RandomEngines.hpp>
+
+namespace genny::v1 {
+
+namespace {
+
+constexpr size_t kSegment = 256;
+
+// What zlib makes of each kind of byte, measured at level 6: random 7-bit bytes cost their
+// entropy and each segment's repeated run costs a back-reference or two.
+constexpr double kRandomCost = 7.0 / 8;
+constexpr double kRunCost = 0.013;
+
+constexpr char kFiller = 'a';
+
+constexpr uint64_t kLow7 = 0x7f7f7f7f7f7f7f7f;
+constexpr uint64_t kHigh = 0x8080808080808080;
+
+/**
+ * @return 8 random bytes in [1, 127]. Zero bytes become 1, which leaves them within a
+ * fraction of a bit of 7 bits of entropy each.
+ */
+uint64_t asciiWord(Xoshiro256StarStar& rng) {
+    const auto word = rng() & kLow7;
+    // Adding 0x7f to a byte sets its top bit unless it was zero. No byte can carry.
+    const auto zero = ~(word + kLow7) & kHigh;
+    return word | (zero >> 7);
+}
+
+}  // namespace
+
+CompressibleStringKernel::CompressibleStringKernel(double ratio) {
+    if (!(ratio >= 0 && ratio <= 1)) {
+        BOOST_THROW_EXCEPTION(std::invalid_argument("Compression ratio must be in [0, 1]"));
+    }
+    const auto fraction = std::clamp((ratio - kRunCost) / kRandomCost, 0.0, 1.0);
+    _randomPerSegment = size_t(std::lround(fraction * kSegment));
+}
+
+void CompressibleStringKernel::fill(char* out, size_t length, uint64_t seed) const {
+    Xoshiro256StarStar rng{seed};
+    // Short strings and the last segment keep the same proportion of random bytes. Rounding
+    // up or down at random keeps that proportion on average even for strings of a few bytes.
+    const auto dither = seed % kSegment;
+    for (size_t start = 0; start < length; start += kSegment) {
+        const auto segment = std::min(kSegment, length - start);
+        const auto random = (segment * _randomPerSegment + dither) / kSegment;
+        char* const end = out + start + random;
+        char* it = out + start;
+        for (; it + sizeof(uint64_t) <= end; it += sizeof(uint64_t)) {
+            const auto word = asciiWord(rng);
+            std::memcpy(it, &word, sizeof(word));
+        }
+        if (it < end) {
+            const auto word = asciiWord(rng);
+            std::memcpy(it, &word, size_t(end - it));
+        }
+        std::memset(end, kFiller, segment - random);
+    }
+}
+
+}  // namespace genny::v1
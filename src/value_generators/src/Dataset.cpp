@@ -0,0 +1,264 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <value_generators/v1/Dataset.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <bsoncxx/exception/exception.hpp>
+#include <bsoncxx/json.hpp>
+
+namespace genny::v1 {
+
+namespace {
+
+uint32_t readLength(const uint8_t* data) {
+    uint32_t length;
+    std::memcpy(&length, data, sizeof(length));
+    return length;
+}
+
+[[noreturn]] void malformed(const std::string& what) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("Malformed BSON: " + what));
+}
+
+/**
+ * @return how many bytes the value of type `type` at `data` takes up, checking it doesn't
+ * run past `available` bytes.
+ */
+size_t valueSize(bsoncxx::type type, const uint8_t* data, size_t available) {
+    auto prefixed = [&](size_t extra) {
+        if (available < 4) {
+            malformed("truncated value");
+        }
+        return 4 + extra + readLength(data);
+    };
+    auto cstring = [&](size_t from) {
+        const auto* end = static_cast<const uint8_t*>(
+            std::memchr(data + from, 0, available > from ? available - from : 0));
+        if (!end) {
+            malformed("unterminated string");
+        }
+        return size_t(end - data) + 1;
+    };
+
+    size_t size;
+    switch (static_cast<uint8_t>(type)) {
+        case 0x06:  // undefined
+        case 0x0A:  // null
+        case 0x7F:  // maxkey
+        case 0xFF:  // minkey
+            size = 0;
+            break;
+        case 0x08:  // bool
+            size = 1;
+            break;
+        case 0x10:  // int32
+            size = 4;
+            break;
+        case 0x01:  // double
+        case 0x09:  // date
+        case 0x11:  // timestamp
+        case 0x12:  // int64
+            size = 8;
+            break;
+        case 0x07:  // oid
+            size = 12;
+            break;
+        case 0x13:  // decimal128
+            size = 16;
+            break;
+        case 0x02:  // utf8
+        case 0x0D:  // code
+        case 0x0E:  // symbol
+            size = prefixed(0);
+            break;
+        case 0x05:  // binary: length, subtype, bytes
+            size = prefixed(1);
+            break;
+        case 0x0C:  // dbpointer: string then oid
+            size = prefixed(12);
+            break;
+        case 0x03:  // document
+        case 0x04:  // array
+        case 0x0F:  // code with scope
+            size = prefixed(0) - 4;
+            break;
+        case 0x0B:  // regex: pattern then options
+            size = cstring(cstring(0));
+            break;
+        default: {
+            std::stringstream msg;
+            msg << "unknown type 0x" << std::hex << int(type);
+            malformed(msg.str());
+        }
+    }
+    if (size > available) {
+        malformed("value runs past the end of its document");
+    }
+    return size;
+}
+
+}  // namespace
+
+Dataset::Dataset(const std::string& path) {
+    const bool json = boost::algorithm::ends_with(path, ".json") ||
+        boost::algorithm::ends_with(path, ".jsonl") ||
+        boost::algorithm::ends_with(path, ".ndjson");
+
+    if (json) {
+        std::ifstream in{path};
+        if (!in) {
+            BOOST_THROW_EXCEPTION(std::invalid_argument("Can't open '" + path + "'"));
+        }
+        std::string line;
+        for (size_t lineNumber = 1; std::getline(in, line); ++lineNumber) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+            try {
+                auto doc = bsoncxx::from_json(line);
+                auto view = doc.view();
+                _converted.insert(_converted.end(), view.data(), view.data() + view.length());
+            } catch (const bsoncxx::exception& ex) {
+                std::stringstream msg;
+                msg << "Invalid JSON on line " << lineNumber << " of '" << path
+                    << "': " << ex.what();
+                BOOST_THROW_EXCEPTION(std::invalid_argument(msg.str()));
+            }
+        }
+        _data = _converted.data();
+        _length = _converted.size();
+    } else {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            BOOST_THROW_EXCEPTION(std::invalid_argument("Can't open '" + path +
+                                                        "': " + std::strerror(errno)));
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            const auto err = errno;
+            ::close(fd);
+            BOOST_THROW_EXCEPTION(std::invalid_argument("Can't stat '" + path +
+                                                        "': " + std::strerror(err)));
+        }
+        void* mapping = MAP_FAILED;
+        if (info.st_size > 0) {
+            mapping = ::mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                const auto err = errno;
+                ::close(fd);
+                BOOST_THROW_EXCEPTION(std::invalid_argument("Can't map '" + path +
+                                                            "': " + std::strerror(err)));
+            }
+        }
+        ::close(fd);
+        if (mapping != MAP_FAILED) {
+            _data = static_cast<const uint8_t*>(mapping);
+            _length = size_t(info.st_size);
+            _mapped = true;
+        }
+    }
+
+    try {
+        index(path);
+    } catch (...) {
+        // The destructor doesn't run if the constructor throws.
+        if (_mapped) {
+            ::munmap(const_cast<uint8_t*>(_data), _length);
+        }
+        throw;
+    }
+}
+
+Dataset::~Dataset() {
+    if (_mapped) {
+        ::munmap(const_cast<uint8_t*>(_data), _length);
+    }
+}
+
+void Dataset::index(const std::string& path) {
+    size_t offset = 0;
+    while (offset < _length) {
+        const auto remaining = _length - offset;
+        const auto length = remaining >= 4 ? readLength(_data + offset) : 0;
+        if (length < 5 || length > remaining || _data[offset + length - 1] != 0) {
+            std::stringstream msg;
+            msg << "'" << path << "' isn't a sequence of BSON documents: bad document at byte "
+                << offset;
+            BOOST_THROW_EXCEPTION(std::invalid_argument(msg.str()));
+        }
+        _offsets.push_back(offset);
+        offset += length;
+    }
+    if (_offsets.empty()) {
+        BOOST_THROW_EXCEPTION(std::invalid_argument("'" + path + "' has no documents"));
+    }
+}
+
+std::optional<RawValue> findValue(bsoncxx::document::view doc,
+                                  const std::vector<std::string>& path) {
+    const uint8_t* data = doc.data();
+    size_t length = doc.length();
+    for (size_t depth = 0; depth < path.size(); ++depth) {
+        const auto& key = path[depth];
+        std::optional<RawValue> found;
+        // Elements sit between the 4-byte length and the trailing NUL.
+        const uint8_t* it = data + 4;
+        const uint8_t* const end = data + length - 1;
+        while (it < end) {
+            const auto type = static_cast<bsoncxx::type>(*it++);
+            const auto* keyEnd = static_cast<const uint8_t*>(std::memchr(it, 0, end - it));
+            if (!keyEnd) {
+                malformed("unterminated key");
+            }
+            const auto* value = keyEnd + 1;
+            const auto size = valueSize(type, value, size_t(end - value));
+            if (size_t(keyEnd - it) == key.size() && std::memcmp(it, key.data(), key.size()) == 0) {
+                found = RawValue{type, value, size};
+                break;
+            }
+            it = value + size;
+        }
+        if (!found) {
+            return std::nullopt;
+        }
+        if (depth + 1 == path.size()) {
+            return found;
+        }
+        if (found->type != bsoncxx::type::k_document && found->type != bsoncxx::type::k_array) {
+            return std::nullopt;
+        }
+        data = found->data;
+        length = found->size;
+        if (length < 5) {
+            malformed("embedded document is too short");
+        }
+    }
+    return RawValue{bsoncxx::type::k_document, doc.data(), doc.length()};
+}
+
+}  // namespace genny::v1
@@ -13,34 +13,193 @@
 // limitations under the License.
 
 #include <value_generators/DocumentGenerator.hpp>
-
+#include <value_generators/v1/CompressibleString.hpp>
+#include <value_generators/v1/Dataset.hpp>
+#include <value_generators/v1/RandomString.hpp>
+#include <value_generators/v1/SkewedDistributions.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <limits>
 #include <map>
+#include <mutex>
+#include <numeric>
+#include <optional>
 #include <sstream>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 #include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/split.hpp>
 #include <boost/date_time.hpp>
 #include <boost/log/trivial.hpp>
 
 #include <bsoncxx/builder/basic/array.hpp>
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/document/element.hpp>
+#include <bsoncxx/types.hpp>
+
+#include <gennylib/v1/WorkerGroup.hpp>
 
 
 namespace {
 
+template <typename U>
+void writeLittleEndian(U value, uint8_t* out) {
+    for (size_t i = 0; i < sizeof(U); ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+/** Append the type byte and NUL-terminated key that start every BSON element. */
+void appendElementHeader(bsoncxx::type type, const std::string& key, std::vector<uint8_t>& out) {
+    out.push_back(static_cast<uint8_t>(type));
+    out.insert(out.end(), key.begin(), key.end());
+    out.push_back(0);
+}
+
+/** Append the elements of `doc` without its length prefix or trailing NUL. */
+void appendElements(bsoncxx::document::view doc, std::vector<uint8_t>& out) {
+    out.insert(out.end(), doc.data() + 4, doc.data() + doc.length() - 1);
+}
+
+/**
+ * Reserve the length prefix of a document or array that starts at the end of `out`.
+ * @return the offset to pass to endDocument().
+ */
+size_t beginDocument(std::vector<uint8_t>& out) {
+    const auto start = out.size();
+    out.resize(start + 4);
+    return start;
+}
+
+void endDocument(size_t start, std::vector<uint8_t>& out) {
+    out.push_back(0);
+    writeLittleEndian(static_cast<uint32_t>(out.size() - start), out.data() + start);
+}
+
 class Appendable {
 public:
     virtual ~Appendable() = default;
     virtual void append(const std::string& key, bsoncxx::builder::basic::document& builder) = 0;
     virtual void append(bsoncxx::builder::basic::array& builder) = 0;
+
+    /**
+     * @return if every call to append() appends the same value. Constant values are serialized
+     * once when the enclosing document is constructed.
+     */
+    virtual bool isConstant() const {
+        return false;
+    }
+
+    /**
+     * @return the BSON type of the value append() adds if that type always encodes to the same
+     * number of bytes (see fixedSize()), otherwise nullopt.
+     */
+    virtual std::optional<bsoncxx::type> fixedType() const {
+        return std::nullopt;
+    }
+
+    /**
+     * Evaluate the next value and write its BSON encoding to the `fixedSize(*fixedType())`
+     * bytes at `out`. Only called if fixedType() is set.
+     */
+    virtual void writeFixed(uint8_t* out) {}
+
+    /**
+     * Evaluate the next value and append it to `out` as a BSON element named `key`.
+     *
+     * This goes through a builder by default. Generators that are common in hot templates
+     * write their bytes directly, so appending to a reused `out` doesn't allocate.
+     */
+    virtual void appendInto(const std::string& key, std::vector<uint8_t>& out) {
+        bsoncxx::builder::basic::document single;
+        append(key, single);
+        appendElements(single.view(), out);
+    }
 };
 
 using UniqueAppendable = std::unique_ptr<Appendable>;
 
+/**
+ * Generates whole documents that already exist somewhere, like a top-level `^FromFile`.
+ */
+class WholeDocumentSource {
+public:
+    virtual ~WholeDocumentSource() = default;
+
+    /**
+     * @return the next document. It is valid for as long as the source is.
+     */
+    virtual bsoncxx::document::view next() = 0;
+};
+
+size_t fixedSize(bsoncxx::type type) {
+    switch (type) {
+        case bsoncxx::type::k_bool:
+            return 1;
+        case bsoncxx::type::k_int32:
+            return 4;
+        default:
+            return 8;
+    }
+}
+
+// Generated types whose BSON value always has the same size. DocumentGenerator leaves a hole of
+// that size in its pre-serialized bytes and overwrites it in place on each evaluation.
+template <typename T>
+struct FixedWidth : std::false_type {};
+
+template <>
+struct FixedWidth<bool> : std::true_type {
+    static constexpr auto type = bsoncxx::type::k_bool;
+    static void write(bool value, uint8_t* out) {
+        *out = value ? 1 : 0;
+    }
+};
+
+template <>
+struct FixedWidth<int32_t> : std::true_type {
+    static constexpr auto type = bsoncxx::type::k_int32;
+    static void write(int32_t value, uint8_t* out) {
+        writeLittleEndian(static_cast<uint32_t>(value), out);
+    }
+};
+
+template <>
+struct FixedWidth<int64_t> : std::true_type {
+    static constexpr auto type = bsoncxx::type::k_int64;
+    static void write(int64_t value, uint8_t* out) {
+        writeLittleEndian(static_cast<uint64_t>(value), out);
+    }
+};
+
+template <>
+struct FixedWidth<double> : std::true_type {
+    static constexpr auto type = bsoncxx::type::k_double;
+    static void write(double value, uint8_t* out) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeLittleEndian(bits, out);
+    }
+};
+
+template <>
+struct FixedWidth<bsoncxx::types::b_date> : std::true_type {
+    static constexpr auto type = bsoncxx::type::k_date;
+    static void write(bsoncxx::types::b_date value, uint8_t* out) {
+        writeLittleEndian(static_cast<uint64_t>(value.to_int64()), out);
+    }
+};
+
 template <class T>
 class Generator : public Appendable {
 public:
@@ -52,8 +211,64 @@ public:
     void append(bsoncxx::builder::basic::array& builder) override {
         builder.append(this->evaluate());
     }
+    std::optional<bsoncxx::type> fixedType() const override {
+        if constexpr (FixedWidth<T>::value) {
+            return FixedWidth<T>::type;
+        } else {
+            return std::nullopt;
+        }
+    }
+    void writeFixed(uint8_t* out) override {
+        if constexpr (FixedWidth<T>::value) {
+            FixedWidth<T>::write(this->evaluate(), out);
+        }
+    }
+    void appendInto(const std::string& key, std::vector<uint8_t>& out) override {
+        if constexpr (FixedWidth<T>::value) {
+            appendElementHeader(FixedWidth<T>::type, key, out);
+            const auto offset = out.size();
+            out.resize(offset + fixedSize(FixedWidth<T>::type));
+            FixedWidth<T>::write(this->evaluate(), out.data() + offset);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            // The length prefix is filled in once the characters are written.
+            appendElementHeader(bsoncxx::type::k_utf8, key, out);
+            const auto offset = out.size();
+            out.resize(offset + 4);
+            appendChars(out);
+            out.push_back(0);
+            writeLittleEndian(static_cast<uint32_t>(out.size() - offset - 4),
+                              out.data() + offset);
+        } else {
+            Appendable::appendInto(key, out);
+        }
+    }
+
+    /**
+     * Evaluate the next string and append its characters, without a terminating NUL, to `out`.
+     * Only called on string generators.
+     *
+     * Generators that build or fill their strings override this to write straight into the
+     * document, or into the enclosing ^Join's output, instead of returning a new string.
+     */
+    virtual void appendChars(std::vector<uint8_t>& out) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            const auto value = this->evaluate();
+            out.insert(out.end(), value.begin(), value.end());
+        }
+    }
 };
 
+/**
+ * @return the characters `appendChars` writes to `scratch`, as a string. `scratch` is reused
+ * across calls so only the returned string allocates.
+ */
+template <class G>
+std::string charsToString(G& generator, std::vector<uint8_t>& scratch) {
+    scratch.clear();
+    generator.appendChars(scratch);
+    return std::string{scratch.begin(), scratch.end()};
+}
+
 template <class T>
 using UniqueGenerator = std::unique_ptr<Generator<T>>;
 
@@ -65,9 +280,99 @@ public:
     T evaluate() override {
         return _value;
     }
+    bool isConstant() const override {
+        return true;
+    }
+    void appendInto(const std::string& key, std::vector<uint8_t>& out) override {
+        if (_encoded.empty()) {
+            // Encode under an empty key: the type byte is followed by that key's NUL and then
+            // the value.
+            bsoncxx::builder::basic::document single;
+            this->append("", single);
+            auto view = single.view();
+            _encoded.push_back(view.data()[4]);
+            _encoded.insert(_encoded.end(), view.data() + 6, view.data() + view.length() - 1);
+        }
+        out.push_back(_encoded.front());
+        out.insert(out.end(), key.begin(), key.end());
+        out.push_back(0);
+        out.insert(out.end(), _encoded.begin() + 1, _encoded.end());
+    }
+    void appendChars(std::vector<uint8_t>& out) override {
+        if constexpr (std::is_same_v<T, std::string>) {
+            out.insert(out.end(), _value.begin(), _value.end());
+        }
+    }
 
 protected:
     T _value;
+
+private:
+    // The type byte followed by the encoded value.
+    std::vector<uint8_t> _encoded;
+};
+
+/**
+ * A generator whose writeFixed() and appendInto() call `Derived::evaluate()` directly instead
+ * of through the vtable. The compiler can then inline the evaluation, so filling in a field
+ * costs one virtual call rather than two. For the fixed-width generators that are common in
+ * hot templates, which should be `final`.
+ */
+template <typename T, class Derived>
+class InlineGenerator : public Generator<T> {
+    static_assert(FixedWidth<T>::value, "InlineGenerator is for fixed-width types");
+
+public:
+    void writeFixed(uint8_t* out) override {
+        FixedWidth<T>::write(self().Derived::evaluate(), out);
+    }
+    void appendInto(const std::string& key, std::vector<uint8_t>& out) override {
+        appendElementHeader(FixedWidth<T>::type, key, out);
+        const auto offset = out.size();
+        out.resize(offset + fixedSize(FixedWidth<T>::type));
+        FixedWidth<T>::write(self().Derived::evaluate(), out.data() + offset);
+    }
+
+private:
+    Derived& self() {
+        return static_cast<Derived&>(*this);
+    }
+};
+
+/**
+ * A parameter of a generator, like the `min` of a `^RandomInt`. Parameters are usually
+ * constants, so once a constant has been evaluated its value is kept and the generator
+ * dropped, and reading it is just a load.
+ *
+ * The first evaluation still happens on first use rather than up front, so errors show up when
+ * they did before.
+ */
+template <typename T>
+class Parameter {
+public:
+    explicit Parameter(UniqueGenerator<T> generator)
+        : _generator{std::move(generator)}, _constant{_generator->isConstant()} {}
+
+    T operator()() {
+        if (!_generator) {
+            return _value;
+        }
+        auto value = _generator->evaluate();
+        if (_constant) {
+            _value = value;
+            _generator.reset();
+        }
+        return value;
+    }
+
+    bool isConstant() const {
+        return _constant;
+    }
+
+private:
+    UniqueGenerator<T> _generator;
+    const bool _constant;
+    T _value{};
 };
 
 }  // namespace
@@ -75,22 +380,165 @@ protected:
 
 namespace genny {
 
+/**
+ * Documents are compiled when they are constructed. Consecutive fields that are constant or
+ * have a fixed-width type (see FixedWidth) are serialized once into a run of BSON bytes. Each
+ * evaluation only overwrites the fixed-width values in place and copies the runs into the
+ * result. Other fields are appended between the runs.
+ *
+ * Fields are evaluated in template order either way, so the random values are the same as if
+ * every field were appended one by one.
+ */
 class DocumentGenerator::Impl : public Generator<bsoncxx::document::value> {
 public:
     using Entries = std::vector<std::pair<std::string, UniqueAppendable>>;
 
-    explicit Impl(Entries entries) : _entries{std::move(entries)} {}
+    explicit Impl(Entries entries) : _entries{std::move(entries)} {
+        compile();
+    }
+
+    /**
+     * A document that is whatever `source` gives, rather than built from a template.
+     */
+    explicit Impl(std::unique_ptr<WholeDocumentSource> source) : _source{std::move(source)} {}
+
+    bool isConstant() const override {
+        return !_source && std::all_of(_entries.begin(), _entries.end(), [](auto&& entry) {
+            return entry.second->isConstant();
+        });
+    }
+
+    /**
+     * @return the next document without copying it if it already exists somewhere, otherwise
+     * nullopt. The view is valid for as long as this Impl is.
+     */
+    std::optional<bsoncxx::document::view> existing() {
+        if (_source) {
+            return _source->next();
+        }
+        return std::nullopt;
+    }
 
     bsoncxx::document::value evaluate() override {
-        bsoncxx::builder::basic::document builder;
-        for (auto&& [k, app] : _entries) {
-            app->append(k, builder);
+        if (_source) {
+            auto view = _source->next();
+            return copyOf(view.data(), view.length());
         }
-        return builder.extract();
+
+        // Fast path: the whole document is a single run.
+        if (_segments.size() == 1 && !_segments.front().entry) {
+            auto& run = _segments.front();
+            fillHoles(run);
+            return copyOf(run.bytes.data(), run.bytes.size());
+        }
+
+        _scratch.clear();
+        writeInto(_scratch);
+        return copyOf(_scratch.data(), _scratch.size());
+    }
+
+    void appendInto(const std::string& key, std::vector<uint8_t>& out) override {
+        appendElementHeader(bsoncxx::type::k_document, key, out);
+        writeInto(out);
+    }
+
+    /**
+     * Append the next document to the end of `out`. Doesn't allocate once `out` has grown to
+     * fit, unless a field's generator does.
+     *
+     * @param id if set, written as an int32 `_id` before the template's fields.
+     */
+    void writeInto(std::vector<uint8_t>& out, std::optional<int32_t> id = std::nullopt) {
+        static const std::string kIdKey = "_id";
+        const auto start = beginDocument(out);
+        if (id) {
+            appendElementHeader(bsoncxx::type::k_int32, kIdKey, out);
+            const auto offset = out.size();
+            out.resize(offset + 4);
+            FixedWidth<int32_t>::write(*id, out.data() + offset);
+        }
+        if (_source) {
+            appendElements(_source->next(), out);
+        }
+        for (auto&& segment : _segments) {
+            if (segment.entry) {
+                segment.entry->second->appendInto(segment.entry->first, out);
+                continue;
+            }
+            fillHoles(segment);
+            out.insert(out.end(), segment.bytes.begin() + 4, segment.bytes.end() - 1);
+        }
+        endDocument(start, out);
     }
 
 private:
+    struct Hole {
+        size_t offset;
+        Appendable* appendable;
+    };
+
+    // Either a run of pre-serialized fields, stored as a complete BSON document, or a single
+    // entry whose encoded size varies.
+    struct Segment {
+        std::vector<uint8_t> bytes;
+        std::vector<Hole> holes;
+        const Entries::value_type* entry = nullptr;
+    };
+
+    void compile() {
+        for (auto&& entry : _entries) {
+            auto& [key, appendable] = entry;
+            const auto type = appendable->fixedType();
+            if (!appendable->isConstant() && !type) {
+                _segments.push_back(Segment{{}, {}, &entry});
+                continue;
+            }
+
+            if (_segments.empty() || _segments.back().entry) {
+                _segments.emplace_back();
+                beginDocument(_segments.back().bytes);
+            }
+            auto& bytes = _segments.back().bytes;
+
+            if (appendable->isConstant()) {
+                bsoncxx::builder::basic::document single;
+                appendable->append(key, single);
+                appendElements(single.view(), bytes);
+            } else {
+                appendElementHeader(*type, key, bytes);
+                _segments.back().holes.push_back(Hole{bytes.size(), appendable.get()});
+                bytes.resize(bytes.size() + fixedSize(*type));
+            }
+        }
+
+        if (_segments.empty()) {
+            _segments.emplace_back();
+            beginDocument(_segments.back().bytes);
+        }
+        for (auto&& segment : _segments) {
+            if (!segment.entry) {
+                endDocument(0, segment.bytes);
+            }
+        }
+    }
+
+    static void fillHoles(Segment& run) {
+        for (auto&& hole : run.holes) {
+            hole.appendable->writeFixed(run.bytes.data() + hole.offset);
+        }
+    }
+
+    static bsoncxx::document::value copyOf(const uint8_t* bytes, size_t size) {
+        auto* data = new uint8_t[size];
+        std::memcpy(data, bytes, size);
+        return bsoncxx::document::value{data, size, [](uint8_t* ptr) { delete[] ptr; }};
+    }
+
     Entries _entries;
+    // Set instead of _entries for documents that come whole.
+    std::unique_ptr<WholeDocumentSource> _source;
+    std::vector<Segment> _segments;
+    std::vector<uint8_t> _scratch;
 };
 
 namespace {
@@ -183,7 +631,10 @@ template <typename Distribution,
           const char* diststring,
           const char* parameter1name,
           const char* parameter2name>
-class DoubleGenerator2Parameter : public Generator<double> {
+class DoubleGenerator2Parameter final
+    : public InlineGenerator<
+          double,
+          DoubleGenerator2Parameter<Distribution, diststring, parameter1name, parameter2name>> {
 public:
     DoubleGenerator2Parameter(const Node& node, GeneratorArgs generatorArgs)
         : _rng{generatorArgs.rng},
@@ -193,8 +644,8 @@ public:
               doubleGenerator(extract(node, parameter2name, diststring), generatorArgs)} {}
 
     double evaluate() override {
-        auto parameter1 = _parameter1Gen->evaluate();
-        auto parameter2 = _parameter2Gen->evaluate();
+        auto parameter1 = _parameter1Gen();
+        auto parameter2 = _parameter2Gen();
         auto dist = Distribution{parameter1, parameter2};
         return dist(_rng);
     }
@@ -202,12 +653,14 @@ public:
 private:
     DefaultRandom& _rng;
     ActorId _actorId;
-    UniqueGenerator<double> _parameter1Gen;
-    UniqueGenerator<double> _parameter2Gen;
+    Parameter<double> _parameter1Gen;
+    Parameter<double> _parameter2Gen;
 };
 
 template <typename Distribution, const char* diststring, const char* parameter1name>
-class DoubleGenerator1Parameter : public Generator<double> {
+class DoubleGenerator1Parameter final
+    : public InlineGenerator<double,
+                             DoubleGenerator1Parameter<Distribution, diststring, parameter1name>> {
 public:
     DoubleGenerator1Parameter(const Node& node, GeneratorArgs generatorArgs)
         : _rng{generatorArgs.rng},
@@ -216,7 +669,7 @@ public:
               doubleGenerator(extract(node, parameter1name, diststring), generatorArgs)} {}
 
     double evaluate() override {
-        auto parameter1 = _parameter1Gen->evaluate();
+        auto parameter1 = _parameter1Gen();
         auto dist = Distribution{parameter1};
         return dist(_rng);
     }
@@ -224,7 +677,7 @@ public:
 private:
     DefaultRandom& _rng;
     ActorId _actorId;
-    UniqueGenerator<double> _parameter1Gen;
+    Parameter<double> _parameter1Gen;
 };
 
 // Constant strings for arguments for templates
@@ -317,8 +770,40 @@ using FisherFDoubleGenerator =
 using StudentTDoubleGenerator =
     DoubleGenerator1Parameter<boost::random::student_t_distribution<double>, studenttstr, nstr>;
 
+/**
+ * The values handed out so far by the `^Inc` with a given `name` in one actor. Lets
+ * `{^RandomInt: {distribution: latest}}` pick recently-generated values.
+ *
+ * The ^Inc and the `latest` can be evaluated on different threads when documents are
+ * pre-generated (see PreGenerator). The ^Inc stores `last` before publishing `count`, so
+ * reading `count` first never picks a value below the first one.
+ */
+struct IncHistory {
+    std::atomic<int64_t> last = 0;
+    int64_t step = 1;
+    std::atomic<uint64_t> count = 0;
+};
+
+/**
+ * @return the history shared by every generator with this actor and name. It lives as long as
+ * any of those generators do.
+ */
+std::shared_ptr<IncHistory> incHistory(ActorId id, const std::string& name) {
+    static std::mutex mutex;
+    static std::map<std::pair<ActorId, std::string>, std::weak_ptr<IncHistory>> histories;
+
+    std::lock_guard<std::mutex> lock{mutex};
+    auto& entry = histories[{id, name}];
+    auto history = entry.lock();
+    if (!history) {
+        history = std::make_shared<IncHistory>();
+        entry = history;
+    }
+    return history;
+}
+
 /** `{^RandomInt:{distribution:uniform ...}}` */
-class UniformInt64Generator : public Generator<int64_t> {
+class UniformInt64Generator final : public InlineGenerator<int64_t, UniformInt64Generator> {
 public:
     /** @param node `{min:<int>, max:<int>}` */
     UniformInt64Generator(const Node& node, GeneratorArgs generatorArgs)
@@ -328,8 +813,8 @@ public:
           _maxGen{intGenerator(extract(node, "max", "uniform"), generatorArgs)} {}
 
     int64_t evaluate() override {
-        auto min = _minGen->evaluate();
-        auto max = _maxGen->evaluate();
+        auto min = _minGen();
+        auto max = _maxGen();
         auto distribution = boost::random::uniform_int_distribution<int64_t>{min, max};
         return distribution(_rng);
     }
@@ -337,12 +822,12 @@ public:
 private:
     DefaultRandom& _rng;
     ActorId _id;
-    UniqueGenerator<int64_t> _minGen;
-    UniqueGenerator<int64_t> _maxGen;
+    Parameter<int64_t> _minGen;
+    Parameter<int64_t> _maxGen;
 };
 
 /** `{^RandomInt:{distribution:binomial ...}}` */
-class BinomialInt64Generator : public Generator<int64_t> {
+class BinomialInt64Generator final : public InlineGenerator<int64_t, BinomialInt64Generator> {
 public:
     /** @param node `{t:<int>, p:double}` */
     BinomialInt64Generator(const Node& node, GeneratorArgs generatorArgs)
@@ -352,7 +837,7 @@ public:
           _p{extract(node, "p", "binomial").to<double>()} {}
 
     int64_t evaluate() override {
-        auto distribution = boost::random::binomial_distribution<int64_t>{_tGen->evaluate(), _p};
+        auto distribution = boost::random::binomial_distribution<int64_t>{_tGen(), _p};
         return distribution(_rng);
     }
 
@@ -360,11 +845,12 @@ private:
     DefaultRandom& _rng;
     ActorId _id;
     double _p;
-    UniqueGenerator<int64_t> _tGen;
+    Parameter<int64_t> _tGen;
 };
 
 /** `{^RandomInt:{distribution:negative_binomial ...}}` */
-class NegativeBinomialInt64Generator : public Generator<int64_t> {
+class NegativeBinomialInt64Generator final
+    : public InlineGenerator<int64_t, NegativeBinomialInt64Generator> {
 public:
     /** @param node `{k:<int>, p:double}` */
     NegativeBinomialInt64Generator(const Node& node, GeneratorArgs generatorArgs)
@@ -375,7 +861,7 @@ public:
 
     int64_t evaluate() override {
         auto distribution =
-            boost::random::negative_binomial_distribution<int64_t>{_kGen->evaluate(), _p};
+            boost::random::negative_binomial_distribution<int64_t>{_kGen(), _p};
         return distribution(_rng);
     }
 
@@ -383,11 +869,11 @@ private:
     DefaultRandom& _rng;
     ActorId _id;
     double _p;
-    UniqueGenerator<int64_t> _kGen;
+    Parameter<int64_t> _kGen;
 };
 
 /** `{^RandomInt:{distribution:poisson...}}` */
-class PoissonInt64Generator : public Generator<int64_t> {
+class PoissonInt64Generator final : public InlineGenerator<int64_t, PoissonInt64Generator> {
 public:
     /** @param node `{mean:double}` */
     PoissonInt64Generator(const Node& node, GeneratorArgs generatorArgs)
@@ -407,7 +893,7 @@ private:
 };
 
 /** `{^RandomInt:{distribution:geometric...}}` */
-class GeometricInt64Generator : public Generator<int64_t> {
+class GeometricInt64Generator final : public InlineGenerator<int64_t, GeometricInt64Generator> {
 public:
     /** @param node `{mean:double}` */
     GeometricInt64Generator(const Node& node, GeneratorArgs generatorArgs)
@@ -426,17 +912,187 @@ private:
     const double _p;
 };
 
+/**
+ * Reads `theta` for the zipfian distributions.
+ */
+double zipfianTheta(const Node& node, const std::string& distribution) {
+    const auto theta = node["theta"].maybe<double>().value_or(0.99);
+    if (!(theta > 0 && theta < 1)) {
+        std::stringstream msg;
+        msg << "'" << distribution << "' requires 0 < theta < 1 but got " << theta;
+        BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(msg.str()));
+    }
+    return theta;
+}
+
+/** `[min, max]` for the distributions that do their set-up once. */
+struct ConstantRange {
+    int64_t min;
+    uint64_t items;
+
+    /** @return the value `offset` past `min`, without signed overflow for wide ranges. */
+    int64_t at(uint64_t offset) const {
+        return int64_t(uint64_t(min) + offset);
+    }
+};
+
+/**
+ * Reads constant `min` and `max`.
+ */
+ConstantRange constantRange(const Node& node, const std::string& distribution) {
+    const auto min = extract(node, "min", distribution).to<int64_t>();
+    const auto max = extract(node, "max", distribution).to<int64_t>();
+    if (max < min) {
+        std::stringstream msg;
+        msg << "'" << distribution << "' requires min <= max but got min " << min << " and max "
+            << max;
+        BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(msg.str()));
+    }
+    // The number of items would be 2^64, which doesn't fit.
+    const auto span = uint64_t(max) - uint64_t(min);
+    if (span == std::numeric_limits<uint64_t>::max()) {
+        std::stringstream msg;
+        msg << "'" << distribution << "' can't range over every int64. Raise min or lower max.";
+        BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(msg.str()));
+    }
+    return {min, span + 1};
+}
+
+/** `{^RandomInt:{distribution:zipfian ...}}` */
+class ZipfianInt64Generator final : public InlineGenerator<int64_t, ZipfianInt64Generator> {
+public:
+    /** @param node `{min:<int>, max:<int>, theta:opt double}`. `min` is the most likely. */
+    ZipfianInt64Generator(const Node& node, GeneratorArgs generatorArgs)
+        : _rng{generatorArgs.rng},
+          _range{constantRange(node, "zipfian")},
+          _distribution{_range.items, zipfianTheta(node, "zipfian")} {}
+
+    int64_t evaluate() override {
+        return _range.at(_distribution(_rng));
+    }
+
+private:
+    DefaultRandom& _rng;
+    const ConstantRange _range;
+    const genny::v1::ZipfianDistribution _distribution;
+};
+
+/** `{^RandomInt:{distribution:scrambled_zipfian ...}}` */
+class ScrambledZipfianInt64Generator final
+    : public InlineGenerator<int64_t, ScrambledZipfianInt64Generator> {
+public:
+    /**
+     * @param node `{min:<int>, max:<int>, theta:opt double}`. Like zipfian but the popular
+     * values are scattered across the range instead of clustered at `min`.
+     */
+    ScrambledZipfianInt64Generator(const Node& node, GeneratorArgs generatorArgs)
+        : _rng{generatorArgs.rng},
+          _range{constantRange(node, "scrambled_zipfian")},
+          _distribution{_range.items, zipfianTheta(node, "scrambled_zipfian")} {}
+
+    int64_t evaluate() override {
+        return _range.at(genny::v1::fnv1a64(_distribution(_rng)) % _range.items);
+    }
+
+private:
+    DefaultRandom& _rng;
+    const ConstantRange _range;
+    const genny::v1::ZipfianDistribution _distribution;
+};
+
+/** `{^RandomInt:{distribution:hotspot ...}}` */
+class HotspotInt64Generator final : public InlineGenerator<int64_t, HotspotInt64Generator> {
+public:
+    /**
+     * @param node `{min:<int>, max:<int>, hotFraction:double, hotOpFraction:double}`.
+     * `hotOpFraction` of the values are uniform over the first `hotFraction` of the range and
+     * the rest are uniform over the remainder.
+     */
+    HotspotInt64Generator(const Node& node, GeneratorArgs generatorArgs)
+        : _rng{generatorArgs.rng},
+          _range{constantRange(node, "hotspot")},
+          _hotFraction{fraction(node, "hotFraction")},
+          _hotOpFraction{fraction(node, "hotOpFraction")},
+          // Always at least one hot value.
+          _hotItems{std::clamp<uint64_t>(uint64_t(_range.items * _hotFraction), 1, _range.items)},
+          _hot{0, _hotItems - 1},
+          _cold{_hotItems, std::max(_hotItems, _range.items - 1)} {}
+
+    int64_t evaluate() override {
+        // With no cold values every value is hot.
+        const bool hot = _hotItems == _range.items ||
+            boost::random::uniform_01<double>{}(_rng) < _hotOpFraction;
+        return _range.at(hot ? _hot(_rng) : _cold(_rng));
+    }
+
+private:
+    static double fraction(const Node& node, const std::string& key) {
+        const auto value = extract(node, key, "hotspot").to<double>();
+        if (!(value >= 0 && value <= 1)) {
+            std::stringstream msg;
+            msg << "'hotspot' requires " << key << " between 0 and 1 but got " << value;
+            BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(msg.str()));
+        }
+        return value;
+    }
+
+    DefaultRandom& _rng;
+    const ConstantRange _range;
+    const double _hotFraction;
+    const double _hotOpFraction;
+    const uint64_t _hotItems;
+    boost::random::uniform_int_distribution<uint64_t> _hot;
+    boost::random::uniform_int_distribution<uint64_t> _cold;
+};
+
+/** `{^RandomInt:{distribution:latest ...}}` */
+class LatestInt64Generator final : public InlineGenerator<int64_t, LatestInt64Generator> {
+public:
+    /**
+     * @param node `{inc:string, theta:opt double}`. Picks values already generated by the
+     * `{^Inc: {name: <inc>}}` in the same actor, zipfian-skewed toward the most recent one.
+     */
+    LatestInt64Generator(const Node& node, GeneratorArgs generatorArgs)
+        : _rng{generatorArgs.rng},
+          _incName{extract(node, "inc", "latest").to<std::string>()},
+          _history{incHistory(generatorArgs.actorId, _incName)},
+          _distribution{1, zipfianTheta(node, "latest")} {}
+
+    int64_t evaluate() override {
+        const auto count = _history->count.load(std::memory_order_acquire);
+        if (count == 0) {
+            std::stringstream msg;
+            msg << "'latest' needs the ^Inc named '" << _incName
+                << "' to have generated a value first";
+            BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(msg.str()));
+        }
+        _distribution.grow(count);
+        const auto last = _history->last.load(std::memory_order_relaxed);
+        return last - int64_t(_distribution(_rng)) * _history->step;
+    }
+
+private:
+    DefaultRandom& _rng;
+    const std::string _incName;
+    const std::shared_ptr<IncHistory> _history;
+    genny::v1::ZipfianDistribution _distribution;
+};
+
 // This generator allows choosing any valid generator, incuding documents. As such it cannot be used
 // by JoinGenerator today. See ChooseStringGenerator.
 class ChooseGenerator : public Appendable {
 public:
     // constructore defined at bottom of the file to use other symbol
     ChooseGenerator(const Node& node, GeneratorArgs generatorArgs);
+
+    size_t chooseIndex() {
+        // boost's discrete_distribution is a Walker/Vose alias table, built once in the
+        // constructor, so each pick is O(1) whatever the number of choices.
+        return _distribution(_rng);
+    }
+
     Appendable& choose() {
-        // Pick a random number between 0 and sum(weights)
-        // Pick value based on that.
-        auto distribution = boost::random::discrete_distribution(_weights);
-        return (*_choices[distribution(_rng)]);
+        return (*_choices[chooseIndex()]);
     }
 
     void append(const std::string& key, bsoncxx::builder::basic::document& builder) override {
@@ -446,11 +1102,59 @@ public:
         choose().append(builder);
     }
 
+    std::optional<bsoncxx::type> fixedType() const override {
+        return _fixedType;
+    }
+    void writeFixed(uint8_t* out) override {
+        const auto& encoded = _encoded[chooseIndex()];
+        std::memcpy(out, encoded.data() + 2, encoded.size() - 2);
+    }
+
+    void appendInto(const std::string& key, std::vector<uint8_t>& out) override {
+        if (_encoded.empty()) {
+            choose().appendInto(key, out);
+            return;
+        }
+        const auto& encoded = _encoded[chooseIndex()];
+        out.push_back(encoded.front());
+        out.insert(out.end(), key.begin(), key.end());
+        out.insert(out.end(), encoded.begin() + 1, encoded.end());
+    }
+
 protected:
+    /**
+     * If every choice is a constant, serialize each one now, so picking one is just a copy.
+     */
+    void preSerialize() {
+        if (!std::all_of(_choices.begin(), _choices.end(), [](auto&& c) {
+                return c->isConstant();
+            })) {
+            return;
+        }
+        for (auto&& choice : _choices) {
+            // An element with an empty key: the type byte, the key's NUL and then the value.
+            _encoded.emplace_back();
+            choice->appendInto("", _encoded.back());
+        }
+
+        // Choices of one fixed-width type can be written in place by the enclosing document.
+        const auto type = _choices.empty() ? std::nullopt : _choices.front()->fixedType();
+        if (type && std::all_of(_choices.begin(), _choices.end(), [&](auto&& c) {
+                return c->fixedType() == type;
+            })) {
+            _fixedType = type;
+        }
+    }
+
     DefaultRandom& _rng;
     ActorId _id;
     std::vector<UniqueAppendable> _choices;
     std::vector<int64_t> _weights;
+    boost::random::discrete_distribution<> _distribution;
+
+    // Each choice's encoding from preSerialize(), if they are all constant.
+    std::vector<std::vector<uint8_t>> _encoded;
+    std::optional<bsoncxx::type> _fixedType;
 };
 
 
@@ -476,165 +1180,526 @@ public:
             // If not passed in, give each choice equal weight
             _weights.assign(_choices.size(), 1);
         }
+        _distribution = boost::random::discrete_distribution<>(_weights);
     }
     std::string evaluate() override {
-        // Pick a random number between 0 and sum(weights)
-        // Pick value based on that.
-        auto distribution = boost::random::discrete_distribution(_weights);
-        return (_choices[distribution(_rng)]->evaluate());
+        // An alias table built once, as in ChooseGenerator.
+        return (_choices[_distribution(_rng)]->evaluate());
     };
+    void appendChars(std::vector<uint8_t>& out) override {
+        _choices[_distribution(_rng)]->appendChars(out);
+    }
 
 protected:
     DefaultRandom& _rng;
     ActorId _id;
     std::vector<UniqueGenerator<std::string>> _choices;
     std::vector<int64_t> _weights;
+    boost::random::discrete_distribution<> _distribution;
+};
+
+class IPGenerator : public Generator<std::string> {
+public:
+    IPGenerator(const Node& node, GeneratorArgs generatorArgs)
+        : _rng{generatorArgs.rng},
+          _id{generatorArgs.actorId},
+          _subnetMask{std::numeric_limits<uint32_t>::max()},
+          _prefix{} {}
+
+    std::string evaluate() override {
+        return charsToString(*this, _scratch);
+    }
+
+    void appendChars(std::vector<uint8_t>& out) override {
+        // Pick a random 32 bit integer
+        // Bitwise add with _subnetMask and add to _prefix
+        // Note that _subnetMask and _prefix are always default values for now.
+        auto distribution = boost::random::uniform_int_distribution<int32_t>{};
+        auto ipint = (distribution(_rng) & _subnetMask) + _prefix;
+        // At most "255.255.255.255".
+        char text[15];
+        char* it = text;
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            it = std::to_chars(it, text + sizeof(text), (ipint >> shift) & 255).ptr;
+            if (shift > 0) {
+                *it++ = '.';
+            }
+        }
+        out.insert(out.end(), text, it);
+    }
+
+protected:
+    DefaultRandom& _rng;
+    ActorId _id;
+    uint32_t _subnetMask;
+    uint32_t _prefix;
+    std::vector<uint8_t> _scratch;
+};
+
+
+// Currently can only join stringGenerators. Ideally any generator would be able to be
+// transformed into a string. To work around this there is a ChooseStringGenerator in addition to
+// the ChooseGenerator, to allow embedding a choose node within a join node, but ideally it would
+// not be neded.
+class JoinGenerator : public Generator<std::string> {
+public:
+    JoinGenerator(const Node& node, GeneratorArgs generatorArgs)
+        : _rng{generatorArgs.rng},
+          _id{generatorArgs.actorId},
+          _separator{node["sep"].maybe<std::string>().value_or("")} {
+        if (!node["array"].isSequence()) {
+            std::stringstream msg;
+            msg << "Malformed node for join array. Not a sequence " << node;
+            BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(msg.str()));
+        }
+        for (const auto&& [k, v] : node["array"]) {
+            _parts.push_back(stringGenerator(v, generatorArgs));
+        }
+    }
+    std::string evaluate() override {
+        return charsToString(*this, _scratch);
+    }
+
+    void appendChars(std::vector<uint8_t>& out) override {
+        bool first = true;
+        for (auto&& part : _parts) {
+            if (first) {
+                first = false;
+            } else {
+                out.insert(out.end(), _separator.begin(), _separator.end());
+            }
+            part->appendChars(out);
+        }
+    }
+
+protected:
+    DefaultRandom& _rng;
+    ActorId _id;
+    std::vector<UniqueGenerator<std::string>> _parts;
+    std::string _separator;
+    std::vector<uint8_t> _scratch;
+};
+
+class StringGenerator : public Generator<std::string> {
+public:
+    StringGenerator(const Node& node, GeneratorArgs generatorArgs)
+        : _rng{generatorArgs.rng},
+          _id{generatorArgs.actorId},
+          _lengthGen{intGenerator(extract(node, "length", "^RandomString"), generatorArgs)},
+          _alphabet{node["alphabet"].maybe<std::string>().value_or(kDefaultAlphabet)},
+          _alphabetLength{_alphabet.size()} {
+        if (_alphabetLength <= 0) {
+            BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(
+                "Random string requires non-empty alphabet if specified"));
+        }
+    }
+
+protected:
+    DefaultRandom& _rng;
+    ActorId _id;
+    Parameter<int64_t> _lengthGen;
+    std::string _alphabet;
+    const size_t _alphabetLength;
+};
+
+/** `{^RandomString:{...}` */
+class NormalRandomStringGenerator : public StringGenerator {
+public:
+    /**
+     * @param node `{length:<int>, alphabet:opt string}`
+     */
+    NormalRandomStringGenerator(const Node& node, GeneratorArgs generatorArgs)
+        : StringGenerator(node, generatorArgs), _distribution{0, _alphabetLength - 1} {}
+
+    std::string evaluate() override {
+        auto length = _lengthGen();
+        std::string str(length, '\0');
+
+        for (int i = 0; i < length; ++i) {
+            str[i] = _alphabet[_distribution(_rng)];
+        }
+
+        return str;
+    }
+
+    void appendChars(std::vector<uint8_t>& out) override {
+        const auto length = _lengthGen();
+        const auto offset = out.size();
+        out.resize(offset + length);
+        for (int64_t i = 0; i < length; ++i) {
+            out[offset + i] = _alphabet[_distribution(_rng)];
+        }
+    }
+
+private:
+    boost::random::uniform_int_distribution<size_t> _distribution;
+};
+
+/** `{^FastRandomString:{...}` */
+class FastRandomStringGenerator : public StringGenerator {
+public:
+    /** @param node `{length:<int>, alphabet:opt str}` */
+    FastRandomStringGenerator(const Node& node, GeneratorArgs generatorArgs)
+        : StringGenerator(node, generatorArgs), _kernel{_alphabet} {}
+
+    std::string evaluate() override {
+        auto length = _lengthGen();
+        std::string str(length, '\0');
+        // Only one draw from the actor's generator however long the string is.
+        _kernel.fill(str.data(), str.size(), _rng());
+        return str;
+    }
+
+    void appendChars(std::vector<uint8_t>& out) override {
+        const auto length = _lengthGen();
+        const auto offset = out.size();
+        out.resize(offset + length);
+        _kernel.fill(reinterpret_cast<char*>(out.data() + offset), length, _rng());
+    }
+
+private:
+    const genny::v1::RandomStringKernel _kernel;
+};
+
+/**
+ * @return a buffer of `size` random characters from `alphabet`. Buffers are shared by every
+ * caller with the same arguments for as long as any of them holds on to it, so each is only
+ * filled once.
+ *
+ * @param actor the actor whose buffer this is, or nullopt to share with the whole workload.
+ * @param rng seeds the buffer if it needs filling.
+ */
+std::shared_ptr<const std::string> randomStringPool(std::optional<ActorId> actor,
+                                                    size_t size,
+                                                    const std::string& alphabet,
+                                                    DefaultRandom& rng) {
+    using Key = std::tuple<std::optional<ActorId>, size_t, std::string>;
+    static std::mutex mutex;
+    static std::map<Key, std::weak_ptr<const std::string>> pools;
+
+    std::lock_guard<std::mutex> lock{mutex};
+    auto& entry = pools[Key{actor, size, alphabet}];
+    auto pool = entry.lock();
+    if (!pool) {
+        auto filled = std::make_shared<std::string>(size, '\0');
+        genny::v1::RandomStringKernel{alphabet}.fill(filled->data(), size, rng());
+        pool = std::move(filled);
+        entry = pool;
+    }
+    return pool;
+}
+
+/** `{^RandomStringPool:{...}` */
+class RandomStringPoolGenerator : public Generator<std::string> {
+public:
+    /**
+     * @param node `{length:<int>, poolSize:opt int, offset:opt random|rolling,
+     *               scope:opt workload|actor, alphabet:opt str}`
+     */
+    RandomStringPoolGenerator(const Node& node, GeneratorArgs generatorArgs)
+        : _rng{generatorArgs.rng},
+          _lengthGen{intGenerator(extract(node, "length", "^RandomStringPool"), generatorArgs)},
+          _rolling{parseOffset(node)},
+          _pool{randomStringPool(parseScope(node, generatorArgs.actorId),
+                                 parsePoolSize(node),
+                                 parseAlphabet(node),
+                                 generatorArgs.rng)},
+          // Start each generator somewhere different so generators sharing a pool don't all
+          // produce the same strings.
+          _offset{boost::random::uniform_int_distribution<size_t>{0, _pool->size() - 1}(_rng)} {}
+
+    std::string evaluate() override {
+        return std::string{next()};
+    }
+
+    void appendChars(std::vector<uint8_t>& out) override {
+        const auto value = next();
+        out.insert(out.end(), value.begin(), value.end());
+    }
+
+private:
+    static bool parseOffset(const Node& node) {
+        const auto offset = node["offset"].maybe<std::string>().value_or("random");
+        if (offset != "random" && offset != "rolling") {
+            BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(
+                "^RandomStringPool offset must be random or rolling but got '" + offset + "'"));
+        }
+        return offset == "rolling";
+    }
+
+    static std::optional<ActorId> parseScope(const Node& node, ActorId id) {
+        const auto scope = node["scope"].maybe<std::string>().value_or("workload");
+        if (scope != "workload" && scope != "actor") {
+            BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(
+                "^RandomStringPool scope must be workload or actor but got '" + scope + "'"));
+        }
+        return scope == "actor" ? std::make_optional(id) : std::nullopt;
+    }
+
+    static size_t parsePoolSize(const Node& node) {
+        // 64MiB by default.
+        const auto size = node["poolSize"].maybe<int64_t>().value_or(int64_t{64} << 20);
+        if (size <= 0) {
+            BOOST_THROW_EXCEPTION(
+                InvalidValueGeneratorSyntax("^RandomStringPool poolSize must be positive"));
+        }
+        return size_t(size);
+    }
+
+    static std::string parseAlphabet(const Node& node) {
+        auto alphabet = node["alphabet"].maybe<std::string>().value_or(kDefaultAlphabet);
+        if (alphabet.empty()) {
+            BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(
+                "Random string requires non-empty alphabet if specified"));
+        }
+        return alphabet;
+    }
+
+    /**
+     * @return the next slice of the pool. It is valid as long as this generator is.
+     */
+    std::string_view next() {
+        const auto length = _lengthGen();
+        if (length < 0 || size_t(length) > _pool->size()) {
+            std::stringstream msg;
+            msg << "^RandomStringPool length " << length << " must be between 0 and poolSize "
+                << _pool->size();
+            BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(msg.str()));
+        }
+        const auto last = _pool->size() - size_t(length);
+        size_t offset;
+        if (_rolling) {
+            if (_offset > last) {
+                _offset = 0;
+            }
+            offset = _offset;
+            _offset += length;
+        } else {
+            offset = boost::random::uniform_int_distribution<size_t>{0, last}(_rng);
+        }
+        return std::string_view{_pool->data() + offset, size_t(length)};
+    }
+
+    DefaultRandom& _rng;
+    Parameter<int64_t> _lengthGen;
+    const bool _rolling;
+    const std::shared_ptr<const std::string> _pool;
+    // Where the next rolling slice starts.
+    size_t _offset;
 };
 
-class IPGenerator : public Generator<std::string> {
+/** `{^CompressibleString:{...}` */
+class CompressibleStringGenerator : public Generator<std::string> {
 public:
-    IPGenerator(const Node& node, GeneratorArgs generatorArgs)
+    /** @param node `{length:<int>, ratio:double}` */
+    CompressibleStringGenerator(const Node& node, GeneratorArgs generatorArgs)
         : _rng{generatorArgs.rng},
-          _id{generatorArgs.actorId},
-          _subnetMask{std::numeric_limits<uint32_t>::max()},
-          _prefix{} {}
+          _lengthGen{intGenerator(extract(node, "length", "^CompressibleString"), generatorArgs)},
+          _kernel{parseRatio(node)} {}
 
     std::string evaluate() override {
-        // Pick a random 32 bit integer
-        // Bitwise add with _subnetMask and add to _prefix
-        // Note that _subnetMask and _prefix are always default values for now.
-        auto distribution = boost::random::uniform_int_distribution<int32_t>{};
-        auto ipint = (distribution(_rng) & _subnetMask) + _prefix;
-        int32_t octets[4];
-        for (int i = 0; i < 4; i++) {
-            octets[i] = ipint & 255;
-            ipint = ipint >> 8;
-        }
-        // convert to a string
-        std::ostringstream ipout;
-        ipout << octets[3] << "." << octets[2] << "." << octets[1] << "." << octets[0];
-        return ipout.str();
+        std::string str(nextLength(), '\0');
+        _kernel.fill(str.data(), str.size(), _rng());
+        return str;
     }
 
-protected:
-    DefaultRandom& _rng;
-    ActorId _id;
-    uint32_t _subnetMask;
-    uint32_t _prefix;
-};
-
+    void appendChars(std::vector<uint8_t>& out) override {
+        const auto length = nextLength();
+        const auto offset = out.size();
+        out.resize(offset + length);
+        _kernel.fill(reinterpret_cast<char*>(out.data() + offset), length, _rng());
+    }
 
-// Currently can only join stringGenerators. Ideally any generator would be able to be
-// transformed into a string. To work around this there is a ChooseStringGenerator in addition to
-// the ChooseGenerator, to allow embedding a choose node within a join node, but ideally it would
-// not be neded.
-class JoinGenerator : public Generator<std::string> {
-public:
-    JoinGenerator(const Node& node, GeneratorArgs generatorArgs)
-        : _rng{generatorArgs.rng},
-          _id{generatorArgs.actorId},
-          _separator{node["sep"].maybe<std::string>().value_or("")} {
-        if (!node["array"].isSequence()) {
+private:
+    static double parseRatio(const Node& node) {
+        const auto ratio = extract(node, "ratio", "^CompressibleString").to<double>();
+        if (!(ratio >= 0 && ratio <= 1)) {
             std::stringstream msg;
-            msg << "Malformed node for join array. Not a sequence " << node;
+            msg << "^CompressibleString ratio must be between 0 and 1 but got " << ratio;
             BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(msg.str()));
         }
-        for (const auto&& [k, v] : node["array"]) {
-            _parts.push_back(stringGenerator(v, generatorArgs));
-        }
+        return ratio;
     }
-    std::string evaluate() override {
-        std::ostringstream output;
-        bool first = true;
-        for (auto&& part : _parts) {
-            if (first) {
-                first = false;
-            } else {
-                output << _separator;
-            }
-            output << part->evaluate();
+
+    size_t nextLength() {
+        const auto length = _lengthGen();
+        if (length < 0) {
+            std::stringstream msg;
+            msg << "^CompressibleString length must not be negative but got " << length;
+            BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(msg.str()));
         }
-        return output.str();
+        return size_t(length);
     }
 
-protected:
     DefaultRandom& _rng;
-    ActorId _id;
-    std::vector<UniqueGenerator<std::string>> _parts;
-    std::string _separator;
+    Parameter<int64_t> _lengthGen;
+    const genny::v1::CompressibleStringKernel _kernel;
 };
 
-class StringGenerator : public Generator<std::string> {
+/**
+ * @return the dataset in the file at `path`. Datasets are shared by every caller with the same
+ * path for as long as any of them holds on to it, so each file is only loaded once.
+ */
+std::shared_ptr<genny::v1::Dataset> dataset(const std::string& path) {
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<genny::v1::Dataset>> datasets;
+
+    std::lock_guard<std::mutex> lock{mutex};
+    auto& entry = datasets[path];
+    auto dataset = entry.lock();
+    if (!dataset) {
+        try {
+            dataset = std::make_shared<genny::v1::Dataset>(path);
+        } catch (const std::invalid_argument& ex) {
+            BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(std::string{"^FromFile: "} +
+                                                              ex.what()));
+        }
+        entry = dataset;
+    }
+    return dataset;
+}
+
+/**
+ * `{^FromFile:{...}}`
+ *
+ * Documents are appended straight from the dataset's bytes. A top-level ^FromFile hands out
+ * views of the dataset itself.
+ */
+class FromFileGenerator : public Appendable, public WholeDocumentSource {
 public:
-    StringGenerator(const Node& node, GeneratorArgs generatorArgs)
+    /** @param node `{path:str, mode:opt sequential|random|shuffled, field:opt str}` */
+    FromFileGenerator(const Node& node, GeneratorArgs generatorArgs)
         : _rng{generatorArgs.rng},
-          _id{generatorArgs.actorId},
-          _lengthGen{intGenerator(extract(node, "length", "^RandomString"), generatorArgs)},
-          _alphabet{node["alphabet"].maybe<std::string>().value_or(kDefaultAlphabet)},
-          _alphabetLength{_alphabet.size()} {
-        if (_alphabetLength <= 0) {
-            BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(
-                "Random string requires non-empty alphabet if specified"));
+          _dataset{dataset(extract(node, "path", "^FromFile").to<std::string>())},
+          _mode{parseMode(node)},
+          _field{parseField(node)} {
+        // Each worker process loads its own copy of the dataset, so they share a position
+        // through the group instead.
+        if (_mode == Mode::kSequential && generatorArgs.thread.workerGroup) {
+            _sharedCursor = &generatorArgs.thread.workerGroup->counter(
+                "^FromFile " + node["path"].to<std::string>());
         }
     }
 
-protected:
-    DefaultRandom& _rng;
-    ActorId _id;
-    UniqueGenerator<int64_t> _lengthGen;
-    std::string _alphabet;
-    const size_t _alphabetLength;
-};
-
-/** `{^RandomString:{...}` */
-class NormalRandomStringGenerator : public StringGenerator {
-public:
-    /**
-     * @param node `{length:<int>, alphabet:opt string}`
-     */
-    NormalRandomStringGenerator(const Node& node, GeneratorArgs generatorArgs)
-        : StringGenerator(node, generatorArgs) {}
+    void append(const std::string& key, bsoncxx::builder::basic::document& builder) override {
+        builder.append(bsoncxx::builder::basic::kvp(key, single(nextValue()).get_value()));
+    }
 
-    std::string evaluate() override {
-        auto distribution = boost::random::uniform_int_distribution<size_t>{0, _alphabetLength - 1};
+    void append(bsoncxx::builder::basic::array& builder) override {
+        builder.append(single(nextValue()).get_value());
+    }
 
-        auto length = _lengthGen->evaluate();
-        std::string str(length, '\0');
+    void appendInto(const std::string& key, std::vector<uint8_t>& out) override {
+        const auto value = nextValue();
+        appendElementHeader(value.type, key, out);
+        out.insert(out.end(), value.data, value.data + value.size);
+    }
 
-        for (int i = 0; i < length; ++i) {
-            str[i] = _alphabet[distribution(_rng)];
+    bsoncxx::document::view next() override {
+        const auto value = nextValue();
+        if (value.type != bsoncxx::type::k_document) {
+            BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(
+                "^FromFile at the top level needs field '" + boost::algorithm::join(_field, ".") +
+                "' to be a document"));
         }
-
-        return str;
+        return bsoncxx::document::view{value.data, value.size};
     }
-};
 
-/** `{^FastRandomString:{...}` */
-class FastRandomStringGenerator : public StringGenerator {
-public:
-    /** @param node `{length:<int>, alphabet:opt str}` */
-    FastRandomStringGenerator(const Node& node, GeneratorArgs generatorArgs)
-        : StringGenerator(node, generatorArgs) {}
+private:
+    enum class Mode { kSequential, kRandom, kShuffled };
 
-    std::string evaluate() override {
-        auto length = _lengthGen->evaluate();
-        std::string str(length, '\0');
+    static Mode parseMode(const Node& node) {
+        const auto mode = node["mode"].maybe<std::string>().value_or("sequential");
+        if (mode == "sequential") {
+            return Mode::kSequential;
+        }
+        if (mode == "random") {
+            return Mode::kRandom;
+        }
+        if (mode == "shuffled") {
+            return Mode::kShuffled;
+        }
+        BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(
+            "^FromFile mode must be sequential, random or shuffled but got '" + mode + "'"));
+    }
 
-        auto randomValue = _rng();
-        int bits = 64;
+    static std::vector<std::string> parseField(const Node& node) {
+        std::vector<std::string> path;
+        if (auto field = node["field"].maybe<std::string>()) {
+            boost::algorithm::split(path, *field, [](char c) { return c == '.'; });
+        }
+        return path;
+    }
 
-        for (int i = 0; i < length; ++i) {
-            if (bits < 6) {
-                randomValue = _rng();
-                bits = 64;
+    size_t nextIndex() {
+        switch (_mode) {
+            case Mode::kSequential:
+                return _sharedCursor ? _dataset->nextSequential(*_sharedCursor)
+                                     : _dataset->nextSequential();
+            case Mode::kRandom:
+                return boost::random::uniform_int_distribution<size_t>{0, _dataset->size() - 1}(
+                    _rng);
+            case Mode::kShuffled:
+                break;
+        }
+        if (_position == _order.size()) {
+            // Start another pass in a new order. Fisher-Yates rather than std::shuffle so
+            // the order is the same whichever standard library genny is built with.
+            if (_order.empty()) {
+                _order.resize(_dataset->size());
+                std::iota(_order.begin(), _order.end(), size_t{0});
             }
+            for (size_t i = _order.size() - 1; i > 0; --i) {
+                std::swap(_order[i],
+                          _order[boost::random::uniform_int_distribution<size_t>{0, i}(_rng)]);
+            }
+            _position = 0;
+        }
+        return _order[_position++];
+    }
 
-            str[i] = _alphabet[(randomValue & 0x2f) % _alphabetLength];
-            randomValue >>= 6;
-            bits -= 6;
+    /**
+     * @return the next document, or the value of `field` in it. Documents that don't have the
+     * field give null.
+     */
+    genny::v1::RawValue nextValue() {
+        const auto doc = (*_dataset)[nextIndex()];
+        if (_field.empty()) {
+            return genny::v1::RawValue{bsoncxx::type::k_document, doc.data(), doc.length()};
         }
-        return str;
+        try {
+            if (auto value = genny::v1::findValue(doc, _field)) {
+                return *value;
+            }
+        } catch (const std::invalid_argument& ex) {
+            BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(std::string{"^FromFile: "} +
+                                                              ex.what()));
+        }
+        return genny::v1::RawValue{bsoncxx::type::k_null, nullptr, 0};
     }
+
+    /**
+     * @return `value` as the only element of `_single`, for appending through a builder.
+     */
+    bsoncxx::document::element single(const genny::v1::RawValue& value) {
+        _single.clear();
+        const auto start = beginDocument(_single);
+        appendElementHeader(value.type, "", _single);
+        _single.insert(_single.end(), value.data, value.data + value.size);
+        endDocument(start, _single);
+        return bsoncxx::document::view{_single.data(), _single.size()}[""];
+    }
+
+    DefaultRandom& _rng;
+    const std::shared_ptr<genny::v1::Dataset> _dataset;
+    const Mode _mode;
+    const std::vector<std::string> _field;
+    // Only set for sequential mode in a worker process.
+    std::atomic_int64_t* _sharedCursor = nullptr;
+    // The current pass in shuffled mode.
+    std::vector<size_t> _order;
+    size_t _position = 0;
+    std::vector<uint8_t> _single;
 };
 
 /** `{^ActorId: {}}` */
@@ -645,6 +1710,9 @@ public:
     int64_t evaluate() override {
         return _actorId;
     }
+    bool isConstant() const override {
+        return true;
+    }
 
 private:
     int64_t _actorId;
@@ -658,6 +1726,12 @@ public:
     std::string evaluate() override {
         return _actorId;
     }
+    bool isConstant() const override {
+        return true;
+    }
+    void appendChars(std::vector<uint8_t>& out) override {
+        out.insert(out.end(), _actorId.begin(), _actorId.end());
+    }
 
 private:
     std::string _actorId;
@@ -691,6 +1765,9 @@ public:
         auto date = _generator->evaluate();
         return date.to_int64();
     }
+    bool isConstant() const override {
+        return _generator->isConstant();
+    }
 
 private:
     const UniqueGenerator<bsoncxx::types::b_date> _generator;
@@ -703,6 +1780,9 @@ public:
     int64_t evaluate() override {
         return (int64_t)_generator->evaluate();
     }
+    bool isConstant() const override {
+        return _generator->isConstant();
+    }
 
 private:
     const UniqueGenerator<double> _generator;
@@ -716,23 +1796,39 @@ public:
         auto datetime = _generator->evaluate();
         return parseStringToMillis(datetime);
     }
+    bool isConstant() const override {
+        return _generator->isConstant();
+    }
 
 private:
     const UniqueGenerator<std::string> _generator;
 };
 
 /** `{^RandomDate: {min: "2015-01-01", max: "2015-01-01T23:59:59.999Z"}}` */
-class RandomDateGenerator : public Generator<bsoncxx::types::b_date> {
+class RandomDateGenerator final
+    : public InlineGenerator<bsoncxx::types::b_date, RandomDateGenerator> {
 public:
     RandomDateGenerator(const Node& node, GeneratorArgs generatorArgs)
         : _rng{generatorArgs.rng},
           _node{node},
           _minGen{dateGenerator(node["min"], generatorArgs)},
-          _maxGen{dateGenerator(node["max"], generatorArgs, max_date)} {}
+          _maxGen{dateGenerator(node["max"], generatorArgs, max_date)} {
+        // Constant bounds, the usual case, are parsed and checked once.
+        if (_minGen.isConstant() && _maxGen.isConstant()) {
+            _constantDistribution = distribution(_minGen(), _maxGen());
+        }
+    }
 
     bsoncxx::types::b_date evaluate() override {
-        auto min = _minGen->evaluate();
-        auto max = _maxGen->evaluate();
+        auto dist = _constantDistribution ? *_constantDistribution
+                                          : distribution(_minGen(), _maxGen());
+        return bsoncxx::types::b_date{std::chrono::milliseconds{dist(_rng)}};
+    }
+
+private:
+    using Distribution = boost::random::uniform_int_distribution<long long>;
+
+    Distribution distribution(int64_t min, int64_t max) const {
         if (max <= min) {
             std::ostringstream msg;
             msg << "^RandomDate: " << _node << ", max (" << max << ") must be greater than min ("
@@ -740,35 +1836,128 @@ public:
             BOOST_LOG_TRIVIAL(warning) << " RandomDateGenerator " << msg.str();
             BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax{msg.str()});
         }
-        boost::random::uniform_int_distribution<long long> dist{min, max - 1};
-        return bsoncxx::types::b_date{std::chrono::milliseconds{dist(_rng)}};
+        return Distribution{min, max - 1};
     }
 
-private:
     DefaultRandom& _rng;
     const Node& _node;
-    const UniqueGenerator<int64_t> _minGen;
-    const UniqueGenerator<int64_t> _maxGen;
+    Parameter<int64_t> _minGen;
+    Parameter<int64_t> _maxGen;
+    std::optional<Distribution> _constantDistribution;
 };
 
 
-class IncGenerator : public Generator<int64_t> {
+/**
+ * @return the counter shared by every `{^Inc: {scope: workload}}` with this key. Like the counters
+ * of a v1::WorkerGroup, it never resets.
+ */
+std::atomic<int64_t>& workloadIncCounter(const std::string& key) {
+    static std::mutex mutex;
+    static std::map<std::string, std::atomic<int64_t>> counters;
+
+    std::lock_guard<std::mutex> lock{mutex};
+    return counters.try_emplace(key, 0).first->second;
+}
+
+/**
+ * `{^Inc: {start: <int>, step: <int>, multiplier: <int>, name: <string>, scope: <string>}}`.
+ *
+ * The `scope` says where the values come from:
+ * - `actor`, the default: counts from 0 with `start` moved on by `actorId * multiplier`.
+ * - `workload`: the next values of a counter shared by every actor, claimed `block` at a time
+ *   so actors rarely contend for it. Counters are shared by name, or by where the ^Inc is in
+ *   the workload if it has none, and by every worker process of `genny run --workers N`.
+ * - `partitioned`: the values for `[0, total)` are split into one contiguous part for each of
+ *   the Actor block's `Threads`.
+ *
+ * The value for count `i` is `start + i * step`. `start` defaults to 0 for the shared scopes
+ * so they hand out exactly the counts.
+ */
+class IncGenerator final : public InlineGenerator<int64_t, IncGenerator> {
 public:
     IncGenerator(const Node& node, GeneratorArgs generatorArgs)
         : _step{node["step"].maybe<int64_t>().value_or(1)} {
-        _counter = node["start"].maybe<int64_t>().value_or(1) +
-            generatorArgs.actorId * node["multiplier"].maybe<int64_t>().value_or(1);
+        const auto scope = node["scope"].maybe<std::string>().value_or("actor");
+        if (scope != "actor" && node["multiplier"]) {
+            BOOST_THROW_EXCEPTION(
+                InvalidValueGeneratorSyntax("^Inc: multiplier only applies to scope: actor"));
+        }
+        if (scope == "actor") {
+            _start = node["start"].maybe<int64_t>().value_or(1) +
+                generatorArgs.actorId * node["multiplier"].maybe<int64_t>().value_or(1);
+            _end = std::numeric_limits<int64_t>::max();
+        } else if (scope == "workload") {
+            _start = node["start"].maybe<int64_t>().value_or(0);
+            _block = node["block"].maybe<int64_t>().value_or(256);
+            if (_block <= 0) {
+                BOOST_THROW_EXCEPTION(
+                    InvalidValueGeneratorSyntax("^Inc: block must be positive"));
+            }
+            const auto name = node["name"].maybe<std::string>();
+            const auto key = name ? "^Inc " + *name : "^Inc at " + node.path();
+            // Worker processes each have their own copy of the process's counters.
+            if (auto workerGroup = generatorArgs.thread.workerGroup) {
+                _shared = &workerGroup->counter(key);
+            } else {
+                _shared = &workloadIncCounter(key);
+            }
+        } else if (scope == "partitioned") {
+            _start = node["start"].maybe<int64_t>().value_or(0);
+            const auto total = node["total"].maybe<int64_t>();
+            if (!total || *total < 0) {
+                BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(
+                    "^Inc: scope: partitioned needs a non-negative total"));
+            }
+            // The first `total % count` parts get one extra value.
+            const auto index = generatorArgs.thread.index;
+            const auto count = generatorArgs.thread.count;
+            const auto part = [&, total = *total, count = int64_t(count)](int64_t i) {
+                return total / count * i + std::min(i, total % count);
+            };
+            _next = part(int64_t(index));
+            _end = part(int64_t(index) + 1);
+        } else {
+            BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(
+                "^Inc: unknown scope '" + scope + "'. Need one of actor/workload/partitioned"));
+        }
+        if (auto name = node["name"].maybe<std::string>()) {
+            _history = incHistory(generatorArgs.actorId, *name);
+            _history->step = _step;
+        }
     }
 
     int64_t evaluate() override {
-        auto inc_value = _counter;
-        _counter += _step;
+        if (_next == _end) {
+            refill();
+        }
+        auto inc_value = _start + _next++ * _step;
+        if (_history) {
+            _history->last.store(inc_value, std::memory_order_relaxed);
+            _history->count.fetch_add(1, std::memory_order_release);
+        }
         return inc_value;
     }
 
 private:
-    int64_t _step;
-    int64_t _counter;
+    void refill() {
+        if (!_shared) {
+            BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(
+                "^Inc: this thread's part of the partitioned total is used up"));
+        }
+        _next = _shared->fetch_add(_block, std::memory_order_relaxed);
+        _end = _next + _block;
+    }
+
+    const int64_t _step;
+    int64_t _start;
+    // The counts still to hand out are [_next, _end).
+    int64_t _next = 0;
+    int64_t _end = 0;
+    // Only set for scope: workload. A workloadIncCounter() or a WorkerGroup's counter.
+    std::atomic<int64_t>* _shared = nullptr;
+    int64_t _block = 0;
+    // Only set for a named ^Inc.
+    std::shared_ptr<IncHistory> _history;
 };
 
 
@@ -777,7 +1966,11 @@ class ArrayGenerator : public Generator<bsoncxx::array::value> {
 public:
     using ValueType = std::vector<UniqueAppendable>;
 
-    explicit ArrayGenerator(ValueType values) : _values{std::move(values)} {}
+    explicit ArrayGenerator(ValueType values) : _values{std::move(values)} {
+        for (size_t i = 0; i < _values.size(); ++i) {
+            _keys.push_back(std::to_string(i));
+        }
+    }
 
     bsoncxx::array::value evaluate() override {
         bsoncxx::builder::basic::array builder{};
@@ -787,8 +1980,25 @@ public:
         return builder.extract();
     }
 
+    bool isConstant() const override {
+        return std::all_of(_values.begin(), _values.end(), [](auto&& value) {
+            return value->isConstant();
+        });
+    }
+
+    void appendInto(const std::string& key, std::vector<uint8_t>& out) override {
+        appendElementHeader(bsoncxx::type::k_array, key, out);
+        const auto start = beginDocument(out);
+        for (size_t i = 0; i < _values.size(); ++i) {
+            _values[i]->appendInto(_keys[i], out);
+        }
+        endDocument(start, out);
+    }
+
 private:
     const ValueType _values;
+    // Array elements are keyed "0", "1", ...
+    std::vector<std::string> _keys;
 };
 
 /**
@@ -888,6 +2098,18 @@ const static std::map<std::string, Parser<UniqueAppendable>> allParsers{
      [](const Node& node, GeneratorArgs generatorArgs) {
          return std::make_unique<FastRandomStringGenerator>(node, generatorArgs);
      }},
+    {"^RandomStringPool",
+     [](const Node& node, GeneratorArgs generatorArgs) {
+         return std::make_unique<RandomStringPoolGenerator>(node, generatorArgs);
+     }},
+    {"^CompressibleString",
+     [](const Node& node, GeneratorArgs generatorArgs) {
+         return std::make_unique<CompressibleStringGenerator>(node, generatorArgs);
+     }},
+    {"^FromFile",
+     [](const Node& node, GeneratorArgs generatorArgs) {
+         return std::make_unique<FromFileGenerator>(node, generatorArgs);
+     }},
     {"^RandomString",
      [](const Node& node, GeneratorArgs generatorArgs) {
          return std::make_unique<NormalRandomStringGenerator>(node, generatorArgs);
@@ -952,6 +2174,10 @@ std::unique_ptr<DocumentGenerator::Impl> documentGenerator(const Node& node,
             if (meta == "^Verbatim") {
                 return documentGenerator<true>(node["^Verbatim"], generatorArgs);
             }
+            if (meta == "^FromFile") {
+                return std::make_unique<DocumentGenerator::Impl>(
+                    std::make_unique<FromFileGenerator>(node["^FromFile"], generatorArgs));
+            }
             std::stringstream msg;
             msg << "Invalid meta-key " << *meta << " at top-level";
             BOOST_THROW_EXCEPTION(InvalidValueGeneratorSyntax(msg.str()));
@@ -1069,6 +2295,14 @@ UniqueGenerator<int64_t> int64GeneratorBasedOnDistribution(const Node& node,
         return std::make_unique<PoissonInt64Generator>(node, generatorArgs);
     } else if (distribution == "geometric") {
         return std::make_unique<GeometricInt64Generator>(node, generatorArgs);
+    } else if (distribution == "zipfian") {
+        return std::make_unique<ZipfianInt64Generator>(node, generatorArgs);
+    } else if (distribution == "scrambled_zipfian") {
+        return std::make_unique<ScrambledZipfianInt64Generator>(node, generatorArgs);
+    } else if (distribution == "hotspot") {
+        return std::make_unique<HotspotInt64Generator>(node, generatorArgs);
+    } else if (distribution == "latest") {
+        return std::make_unique<LatestInt64Generator>(node, generatorArgs);
     } else {
         std::stringstream error;
         error << "Unknown distribution '" << distribution << "'";
@@ -1136,6 +2370,14 @@ UniqueGenerator<std::string> stringGenerator(const Node& node, GeneratorArgs gen
          [](const Node& node, GeneratorArgs generatorArgs) {
              return std::make_unique<FastRandomStringGenerator>(node, generatorArgs);
          }},
+        {"^RandomStringPool",
+         [](const Node& node, GeneratorArgs generatorArgs) {
+             return std::make_unique<RandomStringPoolGenerator>(node, generatorArgs);
+         }},
+        {"^CompressibleString",
+         [](const Node& node, GeneratorArgs generatorArgs) {
+             return std::make_unique<CompressibleStringGenerator>(node, generatorArgs);
+         }},
         {"^RandomString",
          [](const Node& node, GeneratorArgs generatorArgs) {
              return std::make_unique<NormalRandomStringGenerator>(node, generatorArgs);
@@ -1183,6 +2425,123 @@ ChooseGenerator::ChooseGenerator(const Node& node, GeneratorArgs generatorArgs)
         // If not passed in, give each choice equal weight
         _weights.assign(_choices.size(), 1);
     }
+    _distribution = boost::random::discrete_distribution<>(_weights);
+    preSerialize();
+}
+
+/**
+ * @return days since 1970-01-01 of a proleptic Gregorian date. From Howard Hinnant's
+ * `days_from_civil`.
+ */
+int64_t daysFromCivil(int64_t year, int64_t month, int64_t day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int64_t yearOfEra = year - era * 400;
+    const int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+/**
+ * Parse the common ISO-8601 forms without going through locales and streams:
+ * `YYYY-MM-DD`, optionally followed by `T` or a space and `HH:MM:SS`, up to 3 digits of
+ * fractional seconds, and `Z` or a `+HH:MM`/`-HH:MM` offset.
+ *
+ * @return the datetime as millis, or nullopt if `datetime` isn't in one of those forms, in
+ * which case the slower parse in parseStringToMillis() decides what it is.
+ */
+std::optional<int64_t> parseIsoMillis(std::string_view datetime) {
+    size_t pos = 0;
+    // Reads exactly `width` digits.
+    auto number = [&](size_t width) -> std::optional<int64_t> {
+        if (pos + width > datetime.size()) {
+            return std::nullopt;
+        }
+        int64_t value = 0;
+        for (size_t end = pos + width; pos < end; ++pos) {
+            const char c = datetime[pos];
+            if (c < '0' || c > '9') {
+                return std::nullopt;
+            }
+            value = value * 10 + (c - '0');
+        }
+        return value;
+    };
+    auto literal = [&](char c) {
+        if (pos < datetime.size() && datetime[pos] == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    };
+
+    const auto year = number(4);
+    if (!year || !literal('-')) {
+        return std::nullopt;
+    }
+    const auto month = number(2);
+    if (!month || !literal('-')) {
+        return std::nullopt;
+    }
+    const auto day = number(2);
+    // Out-of-range dates are left to boost, which knows what to do with them.
+    static constexpr int kDaysInMonth[] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (!day || *year < 1400 || *month < 1 || *month > 12 || *day < 1 ||
+        *day > kDaysInMonth[*month - 1] ||
+        (*month == 2 && *day == 29 && (*year % 4 != 0 || (*year % 100 == 0 && *year % 400 != 0)))) {
+        return std::nullopt;
+    }
+    int64_t millis = daysFromCivil(*year, *month, *day) * 86400000;
+    if (pos == datetime.size()) {
+        return millis;
+    }
+
+    if (!literal('T') && !literal(' ')) {
+        return std::nullopt;
+    }
+    const auto hours = number(2);
+    if (!hours || !literal(':')) {
+        return std::nullopt;
+    }
+    const auto minutes = number(2);
+    if (!minutes || !literal(':')) {
+        return std::nullopt;
+    }
+    const auto seconds = number(2);
+    if (!seconds || *hours > 23 || *minutes > 59 || *seconds > 59) {
+        return std::nullopt;
+    }
+    millis += ((*hours * 60 + *minutes) * 60 + *seconds) * 1000;
+    if (literal('.')) {
+        int64_t scale = 100;
+        const auto start = pos;
+        for (; pos < datetime.size() && datetime[pos] >= '0' && datetime[pos] <= '9'; ++pos) {
+            millis += (datetime[pos] - '0') * scale;
+            scale /= 10;
+        }
+        if (pos == start || pos - start > 3) {
+            return std::nullopt;
+        }
+    }
+
+    if (literal('Z')) {
+        // UTC.
+    } else if (pos < datetime.size() && (datetime[pos] == '+' || datetime[pos] == '-')) {
+        const int64_t sign = datetime[pos++] == '+' ? 1 : -1;
+        const auto offsetHours = number(2);
+        if (!offsetHours || !literal(':')) {
+            return std::nullopt;
+        }
+        const auto offsetMinutes = number(2);
+        if (!offsetMinutes || *offsetHours > 23 || *offsetMinutes > 59) {
+            return std::nullopt;
+        }
+        millis -= sign * (*offsetHours * 60 + *offsetMinutes) * 60000;
+    }
+    if (pos != datetime.size()) {
+        return std::nullopt;
+    }
+    return millis;
 }
 
 /**
@@ -1193,6 +2552,9 @@ ChooseGenerator::ChooseGenerator(const Node& node, GeneratorArgs generatorArgs)
  *   The datetime as millis.
  */
 int64_t parseStringToMillis(const std::string& datetime) {
+    if (auto millis = parseIsoMillis(datetime)) {
+        return *millis;
+    }
     if (!datetime.empty()) {
         // TODO: PERF-2153 needs some investigation.
         for (const auto& format : formats) {
@@ -1304,23 +2666,105 @@ UniqueGenerator<int64_t> dateGenerator(const Node& node,
     return std::make_unique<ConstantAppender<int64_t>>(millis);
 }
 
+/**
+ * @return the generator for a template in a workload, seeded the way its `RandomSeeding` says.
+ */
+DocumentGenerator workloadGenerator(const Node& node,
+                                    ActorContext& actorContext,
+                                    uint64_t phase,
+                                    ActorId actorId) {
+    auto& workload = actorContext.workload();
+    const auto thread = ActorThread::of(actorContext, actorId);
+    if (auto seed = workload.counterSeed()) {
+        return DocumentGenerator{
+            node,
+            actorId,
+            DocumentGenerator::CounterSeed{*seed, phase, workload.randomEngine()},
+            thread};
+    }
+    return DocumentGenerator{node,
+                             GeneratorArgs{workload.getRNGForThread(actorId), actorId, thread}};
+}
+
+/**
+ * @return a hash of the template and where it is in the workload, so that different templates
+ * seeded by counter draw different values, and so do copies of one template used in two places.
+ * FNV-1a, since std::hash may differ between builds.
+ */
+uint64_t templateHash(const Node& node) {
+    std::ostringstream yaml;
+    // The path can't contain a NUL, so no template and path hash the same as another pair.
+    yaml << node << '\0' << node.path();
+    uint64_t hash = 0xcbf29ce484222325;
+    for (const char c : yaml.str()) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+    }
+    return hash;
+}
+
 }  // namespace
 
+struct DocumentGenerator::Counter {
+    Counter(CounterSeed counterSeed, ActorId actorId, const Node& node)
+        : rng{counterSeed.engine, 0},
+          key{v1::mixSeed(
+              v1::mixSeed(v1::mixSeed(counterSeed.seed, uint64_t(actorId)), counterSeed.phase),
+              templateHash(node))} {}
+
+    DefaultRandom rng;
+    // Everything but the iteration that documents are seeded from.
+    const uint64_t key;
+    uint64_t iteration = 0;
+};
+
 // Kick the recursion into motion
 DocumentGenerator::DocumentGenerator(const Node& node, GeneratorArgs generatorArgs)
     : _impl{documentGenerator<false>(node, generatorArgs)} {}
 DocumentGenerator::DocumentGenerator(const Node& node, PhaseContext& phaseContext, ActorId actorId)
-    : DocumentGenerator{node, GeneratorArgs{phaseContext.rng(actorId), actorId}} {}
+    : DocumentGenerator{workloadGenerator(
+          node, phaseContext.actor(), phaseContext.getPhaseNumber(), actorId)} {}
 DocumentGenerator::DocumentGenerator(const Node& node, ActorContext& actorContext, ActorId actorId)
-    : DocumentGenerator{node, GeneratorArgs{actorContext.rng(actorId), actorId}} {}
+    : DocumentGenerator{
+          workloadGenerator(node, actorContext, CounterSeed::kEveryPhase, actorId)} {}
+DocumentGenerator::DocumentGenerator(const Node& node,
+                                     ActorId actorId,
+                                     CounterSeed counterSeed,
+                                     ActorThread thread)
+    : _counter{std::make_unique<Counter>(counterSeed, actorId, node)},
+      _impl{documentGenerator<false>(node, GeneratorArgs{_counter->rng, actorId, thread})} {}
+
+ActorThread ActorThread::of(const ActorContext& actorContext, ActorId id) {
+    const auto workerGroup = actorContext.orchestrator().workerGroup();
+    const auto index = actorContext.actorIndex(id);
+    if (!index) {
+        return {0, 1, workerGroup};
+    }
+    const auto count = actorContext["Threads"].maybe<int64_t>().value_or(1);
+    return {*index, std::max(size_t(count), *index + 1), workerGroup};
+}
 
 
 DocumentGenerator::DocumentGenerator(DocumentGenerator&&) noexcept = default;
 
 DocumentGenerator::~DocumentGenerator() = default;
 
+void DocumentGenerator::seek(uint64_t iteration) {
+    if (!_counter) {
+        BOOST_THROW_EXCEPTION(
+            std::logic_error("Only DocumentGenerators seeded by counter can seek"));
+    }
+    _counter->iteration = iteration;
+}
+
+void DocumentGenerator::nextDocument() {
+    if (_counter) {
+        _counter->rng.seed(v1::mixSeed(_counter->key, _counter->iteration++));
+    }
+}
+
 // Can't define this before DocumentGenerator::Impl ↑
 bsoncxx::document::value DocumentGenerator::operator()() {
+    nextDocument();
     return _impl->evaluate();
 }
 
@@ -1328,4 +2772,43 @@ bsoncxx::document::value DocumentGenerator::evaluate() {
     return operator()();
 }
 
+bsoncxx::document::view DocumentGenerator::evaluateInto(Buffer& buffer) {
+    nextDocument();
+    if (auto view = _impl->existing()) {
+        return *view;
+    }
+    buffer._bytes.clear();
+    _impl->writeInto(buffer._bytes);
+    return bsoncxx::document::view{buffer._bytes.data(), buffer._bytes.size()};
+}
+
+void DocumentGenerator::appendTo(Arena& arena) {
+    nextDocument();
+    arena._offsets.push_back(arena._bytes.size());
+    _impl->writeInto(arena._bytes);
+}
+
+const std::vector<bsoncxx::document::view>& DocumentGenerator::generateBatch(
+    size_t n, Arena& arena, std::optional<int32_t> firstId) {
+    arena.clear();
+    for (size_t i = 0; i < n; ++i) {
+        nextDocument();
+        arena._offsets.push_back(arena._bytes.size());
+        _impl->writeInto(arena._bytes,
+                         firstId ? std::make_optional(*firstId + static_cast<int32_t>(i))
+                                 : std::nullopt);
+    }
+    return arena.views();
+}
+
+// Views are only made once the arena is done growing, since growing moves the bytes.
+const std::vector<bsoncxx::document::view>& DocumentGenerator::Arena::views() {
+    _views.clear();
+    for (size_t i = 0; i < _offsets.size(); ++i) {
+        const auto end = i + 1 < _offsets.size() ? _offsets[i + 1] : _bytes.size();
+        _views.emplace_back(_bytes.data() + _offsets[i], end - _offsets[i]);
+    }
+    return _views;
+}
+
 }  // namespace genny
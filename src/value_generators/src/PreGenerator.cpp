@@ -0,0 +1,218 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <value_generators/PreGenerator.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include <boost/throw_exception.hpp>
+
+#include <gennylib/v1/ActorScheduler.hpp>
+
+namespace genny {
+
+namespace {
+
+// How many documents a helper generates for one stream before moving on to the next, so one
+// deep stream doesn't keep the others waiting.
+constexpr size_t kBatch = 16;
+
+// How long an idle helper sleeps before looking for free slots again. Doubles while there is
+// nothing to do.
+constexpr auto kMinIdle = std::chrono::microseconds{50};
+constexpr auto kMaxIdle = std::chrono::milliseconds{2};
+
+// How long a consumer in an ActorScheduler sleeps between checks for its next document.
+// Doubles while it waits.
+constexpr auto kMinPause = std::chrono::microseconds{20};
+constexpr auto kMaxPause = std::chrono::milliseconds{1};
+
+}  // namespace
+
+PreGenerator::PreGenerator(size_t threads, size_t depth) : _depth{depth} {
+    if (threads == 0) {
+        BOOST_THROW_EXCEPTION(std::invalid_argument("PreGenerator needs at least one thread"));
+    }
+    if (depth == 0) {
+        BOOST_THROW_EXCEPTION(std::invalid_argument("PreGenerator depth must be positive"));
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        _workers.push_back(std::make_unique<Worker>());
+    }
+}
+
+PreGenerator::~PreGenerator() {
+    _stop = true;
+    for (auto&& worker : _workers) {
+        worker->wake();
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+std::shared_ptr<PreGenerator::Stream> PreGenerator::stream(const Node& node,
+                                                           DefaultRandom rng,
+                                                           ActorId id,
+                                                           ActorThread thread) {
+    return add(std::make_shared<Stream>(node, std::move(rng), id, thread, _depth));
+}
+
+std::shared_ptr<PreGenerator::Stream> PreGenerator::stream(
+    const Node& node, ActorId id, DocumentGenerator::CounterSeed counterSeed, ActorThread thread) {
+    return add(std::make_shared<Stream>(node, id, counterSeed, thread, _depth));
+}
+
+std::shared_ptr<PreGenerator::Stream> PreGenerator::add(std::shared_ptr<Stream> stream) {
+    auto& worker = *_workers[_nextWorker++ % _workers.size()];
+    stream->_preGenerator = this;
+    stream->_worker = &worker;
+    std::lock_guard<std::mutex> lock{worker.mutex};
+    worker.streams.push_back(stream);
+    return stream;
+}
+
+void PreGenerator::start(Worker& worker) {
+    // The new thread inherits the calling consumer's cpu affinity.
+    std::call_once(worker.started,
+                   [&]() { worker.thread = std::thread{[this, &worker]() { work(worker); }}; });
+}
+
+void PreGenerator::work(Worker& worker) {
+    std::chrono::microseconds idle = kMinIdle;
+    while (!_stop.load(std::memory_order_relaxed)) {
+        size_t filled = 0;
+        {
+            std::lock_guard<std::mutex> lock{worker.mutex};
+            for (auto&& stream : worker.streams) {
+                if (stream->_started.load(std::memory_order_relaxed)) {
+                    filled += stream->fill(kBatch);
+                }
+            }
+        }
+        if (filled > 0) {
+            idle = kMinIdle;
+        } else {
+            std::unique_lock<std::mutex> lock{worker.idleMutex};
+            worker.idle.wait_for(lock, idle, [&]() { return worker.woken || _stop; });
+            idle = worker.woken ? kMinIdle
+                                : std::min<std::chrono::microseconds>(idle * 2, kMaxIdle);
+            worker.woken = false;
+        }
+    }
+}
+
+void PreGenerator::Worker::wake() {
+    {
+        std::lock_guard<std::mutex> lock{idleMutex};
+        woken = true;
+    }
+    idle.notify_one();
+}
+
+PreGenerator::Stream::Stream(
+    const Node& node, DefaultRandom rng, ActorId id, ActorThread thread, size_t depth)
+    : _rng{std::move(rng)},
+      _generator{node, GeneratorArgs{_rng, id, thread}},
+      _buffers(depth),
+      _views(depth) {}
+
+// The generator has its own engine so _rng goes unused, but Philox and friends cost nothing.
+PreGenerator::Stream::Stream(const Node& node,
+                             ActorId id,
+                             DocumentGenerator::CounterSeed counterSeed,
+                             ActorThread thread,
+                             size_t depth)
+    : _rng{counterSeed.engine, 0},
+      _generator{node, id, counterSeed, thread},
+      _buffers(depth),
+      _views(depth) {}
+
+size_t PreGenerator::Stream::fill(size_t max) {
+    if (_failed.load(std::memory_order_relaxed)) {
+        return 0;
+    }
+    const auto depth = _buffers.size();
+    auto tail = _tail.load(std::memory_order_relaxed);
+    const auto free = depth - (tail - _head.load(std::memory_order_acquire));
+    const auto count = std::min(max, free);
+    for (size_t i = 0; i < count; ++i, ++tail) {
+        try {
+            _views[tail % depth] = _generator.evaluateInto(_buffers[tail % depth]);
+        } catch (...) {
+            _error = std::current_exception();
+            _failed.store(true);
+            publish();
+            return i;
+        }
+        // Sequentially consistent, like _waiting, so that either the consumer sees the new
+        // tail or publish() sees that it is waiting.
+        _tail.store(tail + 1);
+        publish();
+    }
+    return count;
+}
+
+void PreGenerator::Stream::publish() {
+    if (_waiting.load()) {
+        // Taking the mutex means the consumer is either about to check _tail or already
+        // waiting, so the notification can't be lost.
+        { std::lock_guard<std::mutex> lock{_mutex}; }
+        _ready.notify_one();
+    }
+}
+
+bsoncxx::document::view PreGenerator::Stream::next() {
+    if (!_started.load(std::memory_order_relaxed)) {
+        _started.store(true, std::memory_order_relaxed);
+        _preGenerator->start(*_worker);
+    }
+    auto head = _head.load(std::memory_order_relaxed);
+    if (_holding) {
+        _head.store(++head, std::memory_order_release);
+        _holding = false;
+    }
+    if (_tail.load(std::memory_order_acquire) == head) {
+        await(head);
+    }
+    _holding = true;
+    return _views[head % _views.size()];
+}
+
+void PreGenerator::Stream::await(size_t head) {
+    _worker->wake();
+    const auto ready = [&]() { return _tail.load() != head || _failed.load(); };
+    if (v1::ActorScheduler::isCooperative()) {
+        // Blocking would stall every other actor on this worker thread.
+        auto pause = kMinPause;
+        v1::ActorScheduler::yield();
+        while (!ready()) {
+            v1::ActorScheduler::sleep_for(pause);
+            pause = std::min<std::chrono::microseconds>(pause * 2, kMaxPause);
+        }
+    } else {
+        std::unique_lock<std::mutex> lock{_mutex};
+        _waiting.store(true);
+        _ready.wait(lock, ready);
+        _waiting.store(false, std::memory_order_relaxed);
+    }
+    // Documents published before a failure are consumed before it is rethrown.
+    if (_tail.load(std::memory_order_acquire) == head) {
+        std::rethrow_exception(_error);
+    }
+}
+
+}  // namespace genny
@@ -0,0 +1,225 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <value_generators/v1/RandomString.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/throw_exception.hpp>
+
+#include <value_generators/v1/RandomEngines.hpp>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define GENNY_RANDOM_STRING_X86 1
+#include <immintrin.h>
+#endif
+
+namespace genny::v1 {
+
+namespace {
+
+// Bytes per xoshiro256** draw.
+constexpr size_t kWordBytes = sizeof(uint64_t);
+
+// Each kernel consumes whole draws, using their bytes lowest first, and drops any unused bytes
+// of the last draw. That keeps the vector kernels in step with the scalar one.
+
+void fillMaskedScalar(const uint8_t* table, char* out, size_t length, Xoshiro256StarStar& rng) {
+    for (size_t i = 0; i < length; i += kWordBytes) {
+        auto word = rng();
+        const auto end = std::min(length, i + kWordBytes);
+        for (size_t j = i; j < end; ++j, word >>= 8) {
+            out[j] = static_cast<char>(table[word & 63]);
+        }
+    }
+}
+
+#ifdef GENNY_RANDOM_STRING_X86
+
+__attribute__((target("sse4.1"))) void fillMaskedSse4(const uint8_t* table,
+                                                      char* out,
+                                                      size_t length,
+                                                      Xoshiro256StarStar& rng) {
+    constexpr size_t kStep = sizeof(__m128i);
+    const __m128i t0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table));
+    const __m128i t1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16));
+    const __m128i t2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 32));
+    const __m128i t3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 48));
+    const __m128i lowNibble = _mm_set1_epi8(0x0f);
+    const __m128i twoBits = _mm_set1_epi8(0x03);
+
+    size_t i = 0;
+    for (; i + kStep <= length; i += kStep) {
+        uint64_t words[2] = {rng(), rng()};
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words));
+        // Bits 0-3 pick an entry within a 16-byte quarter of the table, bits 4-5 the quarter.
+        const __m128i lo = _mm_and_si128(bytes, lowNibble);
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), twoBits);
+        // blendv only looks at each byte's top bit, so shift the selector bits there.
+        const __m128i odd = _mm_slli_epi16(hi, 7);
+        const __m128i upper = _mm_slli_epi16(hi, 6);
+        const __m128i first = _mm_blendv_epi8(
+            _mm_shuffle_epi8(t0, lo), _mm_shuffle_epi8(t1, lo), odd);
+        const __m128i second = _mm_blendv_epi8(
+            _mm_shuffle_epi8(t2, lo), _mm_shuffle_epi8(t3, lo), odd);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_blendv_epi8(first, second, upper));
+    }
+    fillMaskedScalar(table, out + i, length - i, rng);
+}
+
+__attribute__((target("avx2"))) void fillMaskedAvx2(const uint8_t* table,
+                                                    char* out,
+                                                    size_t length,
+                                                    Xoshiro256StarStar& rng) {
+    constexpr size_t kStep = sizeof(__m256i);
+    // vpshufb looks up within each 128-bit lane, so each lane gets a copy of every quarter.
+    const __m256i t0 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+    const __m256i t1 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16)));
+    const __m256i t2 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 32)));
+    const __m256i t3 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 48)));
+    const __m256i lowNibble = _mm256_set1_epi8(0x0f);
+    const __m256i twoBits = _mm256_set1_epi8(0x03);
+
+    size_t i = 0;
+    for (; i + kStep <= length; i += kStep) {
+        uint64_t words[4] = {rng(), rng(), rng(), rng()};
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words));
+        // Same as fillMaskedSse4 but 32 bytes at a time.
+        const __m256i lo = _mm256_and_si256(bytes, lowNibble);
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), twoBits);
+        const __m256i odd = _mm256_slli_epi16(hi, 7);
+        const __m256i upper = _mm256_slli_epi16(hi, 6);
+        const __m256i first = _mm256_blendv_epi8(
+            _mm256_shuffle_epi8(t0, lo), _mm256_shuffle_epi8(t1, lo), odd);
+        const __m256i second = _mm256_blendv_epi8(
+            _mm256_shuffle_epi8(t2, lo), _mm256_shuffle_epi8(t3, lo), odd);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm256_blendv_epi8(first, second, upper));
+    }
+    fillMaskedScalar(table, out + i, length - i, rng);
+}
+
+#endif  // GENNY_RANDOM_STRING_X86
+
+}  // namespace
+
+RandomStringKernel::RandomStringKernel(std::string alphabet, std::optional<Isa> isa)
+    : _alphabet{std::move(alphabet)}, _masked{}, _byteToChar{}, _accepted{} {
+    const auto n = _alphabet.size();
+    if (n == 0) {
+        BOOST_THROW_EXCEPTION(std::invalid_argument("Random string requires non-empty alphabet"));
+    }
+
+    if (n <= _masked.size() && (n & (n - 1)) == 0) {
+        _mode = Mode::kMasked;
+        for (size_t i = 0; i < _masked.size(); ++i) {
+            _masked[i] = static_cast<uint8_t>(_alphabet[i % n]);
+        }
+    } else if (n <= _byteToChar.size()) {
+        _mode = Mode::kRejection;
+        // Accept bytes below the largest multiple of n so every character is equally likely.
+        const auto limit = _byteToChar.size() - _byteToChar.size() % n;
+        for (size_t b = 0; b < limit; ++b) {
+            _byteToChar[b] = _alphabet[b % n];
+            _accepted[b] = 1;
+        }
+    } else {
+        _mode = Mode::kWide;
+    }
+
+    if (isa) {
+        if (!supported(*isa)) {
+            BOOST_THROW_EXCEPTION(std::invalid_argument("Instruction set not supported"));
+        }
+        _isa = *isa;
+    } else if (supported(Isa::kAvx2)) {
+        _isa = Isa::kAvx2;
+    } else if (supported(Isa::kSse4)) {
+        _isa = Isa::kSse4;
+    } else {
+        _isa = Isa::kScalar;
+    }
+}
+
+bool RandomStringKernel::supported(Isa isa) {
+    switch (isa) {
+        case Isa::kScalar:
+            return true;
+#ifdef GENNY_RANDOM_STRING_X86
+        case Isa::kSse4:
+            return __builtin_cpu_supports("sse4.1");
+        case Isa::kAvx2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+void RandomStringKernel::fill(char* out, size_t length, uint64_t seed) const {
+    Xoshiro256StarStar rng{seed};
+
+    switch (_mode) {
+        case Mode::kMasked:
+#ifdef GENNY_RANDOM_STRING_X86
+            if (_isa == Isa::kAvx2) {
+                fillMaskedAvx2(_masked.data(), out, length, rng);
+                return;
+            }
+            if (_isa == Isa::kSse4) {
+                fillMaskedSse4(_masked.data(), out, length, rng);
+                return;
+            }
+#endif
+            fillMaskedScalar(_masked.data(), out, length, rng);
+            return;
+
+        case Mode::kRejection: {
+            // Always store the character and only advance if it was accepted; cheaper than a
+            // branch that mispredicts on every rejection.
+            size_t i = 0;
+            while (i < length) {
+                auto word = rng();
+                for (size_t j = 0; j < kWordBytes && i < length; ++j, word >>= 8) {
+                    const auto b = word & 0xff;
+                    out[i] = _byteToChar[b];
+                    i += _accepted[b];
+                }
+            }
+            return;
+        }
+
+        case Mode::kWide: {
+            // Lemire, "Fast Random Integer Generation in an Interval" (2019).
+            const auto n = static_cast<uint32_t>(_alphabet.size());
+            const uint32_t threshold = -n % n;
+            for (size_t i = 0; i < length; ++i) {
+                uint64_t m;
+                do {
+                    m = (rng() & 0xffffffff) * n;
+                } while (static_cast<uint32_t>(m) < threshold);
+                out[i] = _alphabet[m >> 32];
+            }
+            return;
+        }
+    }
+}
+
+}  // namespace genny::v1
@@ -0,0 +1,110 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <value_generators/v1/SkewedDistributions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/throw_exception.hpp>
+
+namespace genny::v1 {
+
+namespace {
+
+// zeta() sums this many terms exactly before switching to Euler-Maclaurin.
+constexpr uint64_t kExactTerms = 10000;
+
+}  // namespace
+
+double zeta(uint64_t n, double theta) {
+    double sum = 0;
+    const auto exact = std::min(n, kExactTerms);
+    for (uint64_t i = 1; i <= exact; ++i) {
+        sum += std::pow(double(i), -theta);
+    }
+    if (n <= kExactTerms) {
+        return sum;
+    }
+
+    // sum(f(i) for i in (m, n]) ~ integral(f, m, n) + (f(n) - f(m)) / 2 + (f'(n) - f'(m)) / 12
+    // with f(x) = x^-theta. The next term is O(m^(-theta-3)).
+    const double m = kExactTerms;
+    const double x = n;
+    const auto f = [&](double v) { return std::pow(v, -theta); };
+    const auto df = [&](double v) { return -theta * std::pow(v, -theta - 1); };
+    const double integral = (std::pow(x, 1 - theta) - std::pow(m, 1 - theta)) / (1 - theta);
+    return sum + integral + (f(x) - f(m)) / 2 + (df(x) - df(m)) / 12;
+}
+
+ZipfianDistribution::ZipfianDistribution(uint64_t items, double theta)
+    : _items{items},
+      _theta{theta},
+      _alpha{1 / (1 - theta)},
+      _zetan{zeta(items, theta)},
+      _zeta2{zeta(2, theta)},
+      _halfPowTheta{1 + std::pow(0.5, theta)} {
+    if (items == 0) {
+        BOOST_THROW_EXCEPTION(std::invalid_argument("Zipfian requires at least one item"));
+    }
+    if (!(theta > 0 && theta < 1)) {
+        BOOST_THROW_EXCEPTION(std::invalid_argument("Zipfian theta must be in (0, 1)"));
+    }
+    computeEta();
+}
+
+void ZipfianDistribution::computeEta() {
+    _eta = (1 - std::pow(2.0 / _items, 1 - _theta)) / (1 - _zeta2 / _zetan);
+}
+
+uint64_t ZipfianDistribution::sample(double u) const {
+    const double uz = u * _zetan;
+    if (uz < 1) {
+        return 0;
+    }
+    if (uz < _halfPowTheta) {
+        return std::min<uint64_t>(1, _items - 1);
+    }
+    const auto rank = uint64_t(_items * std::pow(_eta * u - _eta + 1, _alpha));
+    // Rounding can land exactly on the end when u is close to 1.
+    return std::min(rank, _items - 1);
+}
+
+void ZipfianDistribution::grow(uint64_t items) {
+    if (items <= _items) {
+        return;
+    }
+    if (items - _items <= kExactTerms) {
+        for (auto i = _items + 1; i <= items; ++i) {
+            _zetan += std::pow(double(i), -_theta);
+        }
+    } else {
+        _zetan = zeta(items, _theta);
+    }
+    _items = items;
+    computeEta();
+}
+
+uint64_t fnv1a64(uint64_t value) {
+    uint64_t hash = 0xcbf29ce484222325;
+    for (int i = 0; i < 8; ++i) {
+        hash ^= value & 0xff;
+        hash *= 0x100000001b3;
+        value >>= 8;
+    }
+    return hash;
+}
+
+}  // namespace genny::v1
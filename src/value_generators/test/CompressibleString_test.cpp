@@ -0,0 +1,104 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include <gennylib/Node.hpp>
+
+#include <testlib/helpers.hpp>
+
+#include <value_generators/DefaultRandom.hpp>
+#include <value_generators/DocumentGenerator.hpp>
+#include <value_generators/v1/CompressibleString.hpp>
+
+namespace genny {
+namespace {
+
+/**
+ * @return the size zlib compresses `data` to at its default level, over the size of `data`.
+ */
+double zlibRatio(const std::string& data) {
+    auto size = compressBound(data.size());
+    std::vector<Bytef> compressed(size);
+    REQUIRE(compress2(compressed.data(),
+                      &size,
+                      reinterpret_cast<const Bytef*>(data.data()),
+                      data.size(),
+                      Z_DEFAULT_COMPRESSION) == Z_OK);
+    return double(size) / data.size();
+}
+
+/**
+ * About a megabyte of `length`-byte strings, like a block of documents would hold.
+ */
+std::string concatenated(const v1::CompressibleStringKernel& kernel, size_t length) {
+    DefaultRandom rng;
+    std::string out;
+    std::string value(length, '\0');
+    while (out.size() < (1 << 20)) {
+        kernel.fill(value.data(), length, rng());
+        out += value;
+    }
+    return out;
+}
+
+TEST_CASE("CompressibleStringKernel") {
+    SECTION("Matches the ratio under zlib") {
+        for (double ratio : {0.0, 0.05, 0.1, 0.25, 0.4, 0.6, 0.8}) {
+            for (size_t length : {100, 1000, 30000}) {
+                INFO("ratio=" << ratio << " length=" << length);
+                v1::CompressibleStringKernel kernel{ratio};
+                REQUIRE(zlibRatio(concatenated(kernel, length)) == Approx(ratio).margin(0.015));
+            }
+        }
+    }
+
+    SECTION("Is valid UTF-8 without NULs") {
+        v1::CompressibleStringKernel kernel{1};
+        auto data = concatenated(kernel, 999);
+        REQUIRE(std::all_of(data.begin(), data.end(), [](char c) { return c > 0; }));
+    }
+
+    SECTION("High ratios are fully random") {
+        REQUIRE(v1::CompressibleStringKernel{0.95}.randomPerSegment() == 256);
+        REQUIRE(v1::CompressibleStringKernel{0}.randomPerSegment() == 0);
+    }
+
+    SECTION("Rejects bad ratios") {
+        REQUIRE_THROWS_AS(v1::CompressibleStringKernel{-0.1}, std::invalid_argument);
+        REQUIRE_THROWS_AS(v1::CompressibleStringKernel{1.1}, std::invalid_argument);
+    }
+}
+
+TEST_CASE("^CompressibleString") {
+    NodeSource ns{"a: {^CompressibleString: {length: 2000, ratio: 0.3}}", ""};
+    DefaultRandom rng;
+    DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1}};
+
+    std::string data;
+    for (int i = 0; i < 500; ++i) {
+        auto value = docGen().view()["a"].get_utf8().value;
+        REQUIRE(value.size() == 2000);
+        data.append(value.data(), value.size());
+    }
+    REQUIRE(zlibRatio(data) == Approx(0.3).margin(0.015));
+}
+
+}  // namespace
+}  // namespace genny
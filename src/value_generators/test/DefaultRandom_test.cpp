@@ -15,6 +15,8 @@
 
 #include <algorithm>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 
 #include <boost/random/uniform_int_distribution.hpp>
 
@@ -23,6 +25,8 @@
 
 #include <value_generators/DefaultRandom.hpp>
 
+#include "allocations.hpp"
+
 namespace genny {
 
 namespace {
@@ -96,6 +100,106 @@ TEST_CASE("genny DefaultRandom") {
         }
     }
 }
+
+TEST_CASE("DefaultRandom engines") {
+    const auto engines = {v1::EngineType::kMt19937_64,
+                          v1::EngineType::kXoshiro256StarStar,
+                          v1::EngineType::kPcg64,
+                          v1::EngineType::kPhilox4x64};
+
+    SECTION("Parses engine names") {
+        REQUIRE(v1::parseEngineType("mt19937_64") == v1::EngineType::kMt19937_64);
+        REQUIRE(v1::parseEngineType("xoshiro256**") == v1::EngineType::kXoshiro256StarStar);
+        REQUIRE(v1::parseEngineType("pcg64") == v1::EngineType::kPcg64);
+        REQUIRE(v1::parseEngineType("philox4x64") == v1::EngineType::kPhilox4x64);
+        REQUIRE_THROWS_AS(v1::parseEngineType("mt19937"), std::invalid_argument);
+    }
+
+    SECTION("Default engine is unchanged") {
+        DefaultRandom rng{v1::EngineType::kMt19937_64, 12345};
+        boost::random::mt19937_64 expected{12345};
+        for (int i = 0; i < 10; ++i) {
+            REQUIRE(rng() == expected());
+        }
+    }
+
+    SECTION("Philox4x64-10 matches the Random123 known-answer vector") {
+        DefaultRandom rng{v1::EngineType::kPhilox4x64, 0};
+        REQUIRE(rng() == 0x16554d9eca36314cull);
+        REQUIRE(rng() == 0xdb20fe9d672d0fdcull);
+        REQUIRE(rng() == 0xd7e772cee186176bull);
+        REQUIRE(rng() == 0x7e68b68aec7ba23bull);
+    }
+
+    SECTION("Every engine is seeded") {
+        for (auto engine : engines) {
+            DefaultRandom a{engine, 1};
+            DefaultRandom b{engine, 1};
+            DefaultRandom c{engine, 2};
+            std::vector<uint64_t> fromA, fromB, fromC;
+            for (int i = 0; i < 10; ++i) {
+                fromA.push_back(a());
+                fromB.push_back(b());
+                fromC.push_back(c());
+            }
+            REQUIRE(fromA == fromB);
+            REQUIRE(fromA != fromC);
+
+            a.seed(2);
+            REQUIRE(a() == fromC[0]);
+        }
+    }
+
+    SECTION("Children use their parent's engine") {
+        for (auto engine : engines) {
+            DefaultRandom parent{engine, 5};
+            REQUIRE(parent.child().engineType() == engine);
+        }
+    }
+
+    SECTION("Distributions see the whole range") {
+        for (auto engine : engines) {
+            DefaultRandom rng{engine, 7};
+            boost::random::uniform_int_distribution<int64_t> dist{0, 9};
+            std::vector<int> counts(10);
+            for (int i = 0; i < 10000; ++i) {
+                ++counts[dist(rng)];
+            }
+            for (auto count : counts) {
+                REQUIRE(count > 800);
+                REQUIRE(count < 1200);
+            }
+        }
+    }
+
+    SECTION("Mixed seeds depend on every value and their order") {
+        REQUIRE(v1::mixSeed(1, 2) == v1::mixSeed(1, 2));
+        REQUIRE(v1::mixSeed(1, 2) != v1::mixSeed(2, 1));
+        REQUIRE(v1::mixSeed(1, 2) != v1::mixSeed(1, 3));
+        REQUIRE(v1::mixSeed(v1::mixSeed(0, 1), 2) != v1::mixSeed(v1::mixSeed(0, 2), 1));
+    }
+
+    SECTION("mt19937_64 allocates its state on first use") {
+        allocations = 0;
+        countAllocations = true;
+        DefaultRandom unused;
+        DefaultRandom replaced;
+        replaced = DefaultRandom{v1::EngineType::kPcg64, 3};
+        countAllocations = false;
+        REQUIRE(allocations == 0);
+
+        DefaultRandom rng{v1::EngineType::kMt19937_64, 12345};
+        rng.seed(54321);
+        boost::random::mt19937_64 expected{54321};
+        REQUIRE(rng() == expected());
+        REQUIRE(rng() == expected());
+    }
+
+    SECTION("The fast engines are small") {
+        // The variant plus its tag; mt19937_64 is behind a pointer.
+        REQUIRE(sizeof(DefaultRandom) <= 128);
+    }
+}
 }  // namespace
 
 }  // namespace genny
@@ -0,0 +1,336 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <bsoncxx/json.hpp>
+
+#include <gennylib/Node.hpp>
+#include <gennylib/v1/WorkerGroup.hpp>
+
+#include <testlib/helpers.hpp>
+
+#include <value_generators/DefaultRandom.hpp>
+#include <value_generators/DocumentGenerator.hpp>
+
+#include "allocations.hpp"
+
+namespace genny {
+namespace {
+
+bool sameBytes(bsoncxx::document::view lhs, bsoncxx::document::view rhs) {
+    return lhs.length() == rhs.length() && std::memcmp(lhs.data(), rhs.data(), lhs.length()) == 0;
+}
+
+TEST_CASE("DocumentGenerator evaluateInto") {
+    SECTION("Generates the same bytes as evaluate()") {
+        NodeSource ns{R"(
+            a: 1
+            b: {^RandomInt: {min: 10, max: 1000000}}
+            c: constant
+            d: {^RandomString: {length: {^RandomInt: {min: 2, max: 40}}}}
+            e: {f: {^RandomDouble: {min: 0, max: 1}}, g: [1, {^Inc: {}}, {h: null}]}
+            i: {^Choose: {from: [1, two, {three: 3}, [4]]}}
+            j: {^Join: {array: [x, {^IP: {}}], sep: "-"}}
+            k: {^ActorId: {}}
+            l: {m: true, n: 2.5}
+        )",
+                      ""};
+        DefaultRandom rng1;
+        DefaultRandom rng2;
+        DocumentGenerator byValue{ns.root(), GeneratorArgs{rng1, 3}};
+        DocumentGenerator intoBuffer{ns.root(), GeneratorArgs{rng2, 3}};
+
+        DocumentGenerator::Buffer buffer;
+        for (int i = 0; i < 50; ++i) {
+            auto expected = byValue();
+            auto actual = intoBuffer.evaluateInto(buffer);
+            INFO("Expected = " << bsoncxx::to_json(expected.view())
+                               << "\nActual = " << bsoncxx::to_json(actual));
+            REQUIRE(sameBytes(expected.view(), actual));
+        }
+    }
+
+    SECTION("Empty document") {
+        NodeSource ns{"{}", ""};
+        DefaultRandom rng;
+        DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1}};
+        DocumentGenerator::Buffer buffer;
+        REQUIRE(sameBytes(docGen.evaluateInto(buffer), docGen().view()));
+    }
+
+    // Strings are longer than std::string's small-string buffer, so any temporary std::string
+    // for them would allocate.
+    SECTION("Doesn't allocate once the buffer has grown") {
+        NodeSource ns{R"(
+            a: 1
+            b: {^RandomInt: {min: 10, max: 1000000}}
+            c: {^RandomString: {length: 64}}
+            d: {e: {^RandomDouble: {min: 0, max: 1}}, f: [x, {^Inc: {}}, {g: null}]}
+            h: {^ActorIdString: {}}
+            i: [{^RandomInt: {min: 1, max: 2}}, {^Now: {}}]
+            j: {^Choose: {from: [a, b, {c: 1}], weights: [1, 2, 3]}}
+            k: {^Choose: {from: [1, 2]}}
+            l: {^RandomStringPool: {length: 100, poolSize: 4096}}
+            m: {^CompressibleString: {length: 300, ratio: 0.4}}
+            n: {^FastRandomString: {length: {^RandomInt: {min: 40, max: 200}}}}
+            o: {^Join: {array: [{^RandomString: {length: 50}}, {^IP: {}}], sep: "-"}}
+        )",
+                      ""};
+        DefaultRandom rng;
+        DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1}};
+        DocumentGenerator::Buffer buffer;
+
+        // Warm up the buffer and each constant's cached encoding.
+        for (int i = 0; i < 10; ++i) {
+            docGen.evaluateInto(buffer);
+        }
+
+        allocations = 0;
+        countAllocations = true;
+        for (int i = 0; i < 1000; ++i) {
+            docGen.evaluateInto(buffer);
+        }
+        countAllocations = false;
+
+        REQUIRE(allocations == 0);
+    }
+}
+
+TEST_CASE("DocumentGenerator generateBatch") {
+    NodeSource ns{R"(
+        a: {^RandomInt: {min: 10, max: 1000000}}
+        b: {^RandomString: {length: {^RandomInt: {min: 2, max: 40}}}}
+        c: [1, {d: 2}]
+    )",
+                  ""};
+    DefaultRandom rng1;
+    DefaultRandom rng2;
+    DocumentGenerator byValue{ns.root(), GeneratorArgs{rng1, 1}};
+    DocumentGenerator inBatches{ns.root(), GeneratorArgs{rng2, 1}};
+    DocumentGenerator::Arena arena;
+
+    SECTION("Generates the same documents as evaluate()") {
+        for (int batch = 0; batch < 5; ++batch) {
+            auto& docs = inBatches.generateBatch(20, arena);
+            REQUIRE(docs.size() == 20);
+            REQUIRE(arena.size() == 20);
+            for (auto&& doc : docs) {
+                auto expected = byValue();
+                REQUIRE(sameBytes(expected.view(), doc));
+            }
+        }
+    }
+
+    SECTION("Numbers documents from firstId") {
+        auto& docs = inBatches.generateBatch(3, arena, 41);
+        for (int i = 0; i < 3; ++i) {
+            auto expected = byValue();
+            auto doc = docs[i];
+
+            // An int32 element named _id.
+            const uint8_t id[] = {0x10, '_', 'i', 'd', 0, uint8_t(41 + i), 0, 0, 0};
+            REQUIRE(std::memcmp(doc.data() + 4, id, sizeof(id)) == 0);
+
+            // Followed by the rest of the document.
+            REQUIRE(doc.length() == expected.view().length() + 9);
+            REQUIRE(std::memcmp(doc.data() + 13, expected.view().data() + 4,
+                                expected.view().length() - 4) == 0);
+        }
+    }
+
+    SECTION("Appending to an arena") {
+        arena.clear();
+        for (int i = 0; i < 3; ++i) {
+            inBatches.appendTo(arena);
+        }
+        auto& docs = arena.views();
+        REQUIRE(docs.size() == 3);
+        for (auto&& doc : docs) {
+            REQUIRE(sameBytes(byValue().view(), doc));
+        }
+    }
+
+    SECTION("Reuses the arena") {
+        NodeSource fixed{R"({
+            a: {^RandomInt: {min: 1, max: 100}},
+            b: [{^Inc: {}}, x],
+            c: {^RandomString: {length: {^RandomInt: {min: 40, max: 200}}}}
+        })",
+                         ""};
+        DocumentGenerator docGen{fixed.root(), GeneratorArgs{rng1, 1}};
+        docGen.generateBatch(100, arena);
+
+        allocations = 0;
+        countAllocations = true;
+        for (int i = 0; i < 10; ++i) {
+            docGen.generateBatch(100, arena);
+        }
+        countAllocations = false;
+
+        REQUIRE(allocations == 0);
+    }
+}
+
+TEST_CASE("DocumentGenerator seeded by counter") {
+    NodeSource ns{R"({
+        a: {^RandomInt: {min: 0, max: 1000000000}},
+        b: {^FastRandomString: {length: {^RandomInt: {min: 1, max: 40}}}},
+        c: {^Choose: {from: [x, y, z]}}
+    })",
+                  ""};
+    const DocumentGenerator::CounterSeed counterSeed{5, 2, v1::EngineType::kPhilox4x64};
+    auto generator = [&](ActorId id, DocumentGenerator::CounterSeed seed) {
+        return DocumentGenerator{ns.root(), id, seed};
+    };
+
+    DocumentGenerator inOrder = generator(1, counterSeed);
+    std::vector<bsoncxx::document::value> expected;
+    for (int i = 0; i < 50; ++i) {
+        expected.push_back(inOrder());
+    }
+
+    SECTION("Documents depend only on their iteration") {
+        DocumentGenerator outOfOrder = generator(1, counterSeed);
+        for (int i : {7, 3, 49, 0, 3}) {
+            outOfOrder.seek(i);
+            REQUIRE(sameBytes(outOfOrder().view(), expected[i].view()));
+        }
+        // Carries on from the last document.
+        REQUIRE(sameBytes(outOfOrder().view(), expected[4].view()));
+    }
+
+    SECTION("Every way of generating agrees") {
+        DocumentGenerator other = generator(1, counterSeed);
+        DocumentGenerator::Buffer buffer;
+        DocumentGenerator::Arena arena;
+        REQUIRE(sameBytes(other.evaluateInto(buffer), expected[0].view()));
+        other.appendTo(arena);
+        REQUIRE(sameBytes(arena.views()[0], expected[1].view()));
+        auto& batch = other.generateBatch(3, arena);
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(sameBytes(batch[i], expected[2 + i].view()));
+        }
+    }
+
+    SECTION("Actors, phases and seeds get their own documents") {
+        auto differ = [&](DocumentGenerator docGen) {
+            return !sameBytes(docGen().view(), expected[0].view());
+        };
+        REQUIRE(differ(generator(2, counterSeed)));
+        REQUIRE(differ(generator(1, {5, 3, v1::EngineType::kPhilox4x64})));
+        REQUIRE(differ(generator(1, {6, 2, v1::EngineType::kPhilox4x64})));
+    }
+
+    SECTION("The same template in two places gets its own documents") {
+        NodeSource twice{R"({
+            first: {a: {^RandomInt: {min: 0, max: 1000000000}}},
+            second: {a: {^RandomInt: {min: 0, max: 1000000000}}}
+        })",
+                         ""};
+        DocumentGenerator first{twice.root()["first"], 1, counterSeed};
+        DocumentGenerator second{twice.root()["second"], 1, counterSeed};
+        REQUIRE(!sameBytes(first().view(), second().view()));
+    }
+
+    SECTION("Only generators seeded by counter can seek") {
+        DefaultRandom rng;
+        DocumentGenerator streamed{ns.root(), GeneratorArgs{rng, 1}};
+        REQUIRE_THROWS_AS(streamed.seek(0), std::logic_error);
+    }
+}
+
+TEST_CASE("^Inc scopes") {
+    DefaultRandom rng;
+    auto values = [](DocumentGenerator& docGen, int n) {
+        std::vector<int64_t> out;
+        for (int i = 0; i < n; ++i) {
+            out.push_back(docGen().view()["n"].get_int64().value);
+        }
+        return out;
+    };
+
+    SECTION("Partitioned splits the total between threads") {
+        NodeSource ns{"{n: {^Inc: {scope: partitioned, total: 11, start: 100, step: 10}}}", ""};
+        std::vector<int64_t> all;
+        for (size_t index = 0; index < 3; ++index) {
+            DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1, ActorThread{index, 3}}};
+            // The first 11 % 3 threads get one more.
+            auto part = values(docGen, index < 2 ? 4 : 3);
+            all.insert(all.end(), part.begin(), part.end());
+            REQUIRE_THROWS_AS(docGen(), InvalidValueGeneratorSyntax);
+        }
+        std::vector<int64_t> expected;
+        for (int64_t i = 0; i < 11; ++i) {
+            expected.push_back(100 + 10 * i);
+        }
+        REQUIRE(all == expected);
+    }
+
+    SECTION("Workload hands out each value once across actors") {
+        NodeSource ns{"{n: {^Inc: {scope: workload, block: 4, name: incScopesTest}}}", ""};
+        DocumentGenerator first{ns.root(), GeneratorArgs{rng, 1}};
+        DocumentGenerator second{ns.root(), GeneratorArgs{rng, 2}};
+        REQUIRE(values(first, 2) == std::vector<int64_t>{0, 1});
+        REQUIRE(values(second, 5) == std::vector<int64_t>{4, 5, 6, 7, 8});
+        REQUIRE(values(first, 3) == std::vector<int64_t>{2, 3, 12});
+    }
+
+    SECTION("Workload counters without a name are kept apart by where they are") {
+        NodeSource ns{
+            "{a: {^Inc: {scope: workload, block: 1}}, b: {^Inc: {scope: workload, block: 1}}}",
+            ""};
+        DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1}};
+        for (int64_t i = 0; i < 3; ++i) {
+            const auto doc = docGen();
+            REQUIRE(doc.view()["a"].get_int64().value == i);
+            REQUIRE(doc.view()["b"].get_int64().value == i);
+        }
+    }
+
+    SECTION("Workload counters carry on after their generators are gone") {
+        NodeSource ns{"{n: {^Inc: {scope: workload, block: 2, name: incLifetimeTest}}}", ""};
+        {
+            DocumentGenerator first{ns.root(), GeneratorArgs{rng, 1}};
+            REQUIRE(values(first, 1) == std::vector<int64_t>{0});
+        }
+        DocumentGenerator second{ns.root(), GeneratorArgs{rng, 1}};
+        REQUIRE(values(second, 2) == std::vector<int64_t>{2, 3});
+    }
+
+    SECTION("Workload hands out each value once across worker processes") {
+        v1::WorkerGroup group{2};
+        NodeSource ns{"{n: {^Inc: {scope: workload, block: 4, name: incWorkersTest}}}", ""};
+        DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1, ActorThread{0, 1, &group}}};
+        const pid_t child = fork();
+        if (child == 0) {
+            group.joinAs(1);
+            docGen();
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(child, &status, 0);
+        REQUIRE(WIFEXITED(status));
+        REQUIRE(values(docGen, 2) == std::vector<int64_t>{4, 5});
+    }
+}
+
+}  // namespace
+}  // namespace genny
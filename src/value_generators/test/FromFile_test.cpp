@@ -0,0 +1,294 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <boost/filesystem.hpp>
+
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+
+#include <gennylib/Node.hpp>
+#include <gennylib/v1/WorkerGroup.hpp>
+
+#include <testlib/helpers.hpp>
+
+#include <value_generators/DefaultRandom.hpp>
+#include <value_generators/DocumentGenerator.hpp>
+#include <value_generators/v1/Dataset.hpp>
+
+namespace genny {
+namespace {
+
+using bsoncxx::builder::basic::kvp;
+
+constexpr int64_t kDocuments = 100;
+
+/**
+ * A scratch file that is removed when it goes out of scope.
+ */
+struct TempFile {
+    explicit TempFile(const std::string& extension)
+        : path{(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path())
+                   .string() +
+               extension} {}
+
+    ~TempFile() {
+        boost::filesystem::remove(path);
+    }
+
+    void write(const std::string& contents) const {
+        std::ofstream{path, std::ios::binary} << contents;
+    }
+
+    const std::string path;
+};
+
+/**
+ * @return `kDocuments` documents like `{i: 3, name: "n3", address: {city: "c3"}}`, back to back.
+ */
+std::string dataset() {
+    std::string bytes;
+    for (int64_t i = 0; i < kDocuments; ++i) {
+        bsoncxx::builder::basic::document address;
+        address.append(kvp("city", "c" + std::to_string(i)));
+        bsoncxx::builder::basic::document doc;
+        doc.append(kvp("i", i),
+                   kvp("name", "n" + std::to_string(i)),
+                   kvp("address", address.extract()));
+        auto view = doc.view();
+        bytes.append(reinterpret_cast<const char*>(view.data()), view.length());
+    }
+    return bytes;
+}
+
+std::string fromFile(const TempFile& file, const std::string& options) {
+    return "{^FromFile: {path: '" + file.path + "'" + options + "}}";
+}
+
+/**
+ * @return `i` from `n` documents generated from `yaml`.
+ */
+std::vector<int64_t> draw(const std::string& yaml, int64_t n, uint64_t seed = 5) {
+    NodeSource ns{yaml, ""};
+    DefaultRandom rng{seed};
+    DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1}};
+    std::vector<int64_t> out;
+    for (int64_t j = 0; j < n; ++j) {
+        out.push_back(docGen().view()["i"].get_int64().value);
+    }
+    return out;
+}
+
+std::vector<int64_t> sorted(std::vector<int64_t> values) {
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+std::vector<int64_t> allIndexes() {
+    std::vector<int64_t> out;
+    for (int64_t i = 0; i < kDocuments; ++i) {
+        out.push_back(i);
+    }
+    return out;
+}
+
+TEST_CASE("^FromFile") {
+    TempFile file{".bson"};
+    file.write(dataset());
+
+    SECTION("Top-level documents are the file's documents") {
+        NodeSource ns{fromFile(file, ""), ""};
+        DefaultRandom rng;
+        DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1}};
+        v1::Dataset expected{file.path};
+        DocumentGenerator::Buffer buffer;
+        for (int64_t i = 0; i < kDocuments; ++i) {
+            auto view = docGen.evaluateInto(buffer);
+            REQUIRE(std::equal(view.data(),
+                               view.data() + view.length(),
+                               expected[i].data(),
+                               expected[i].data() + expected[i].length()));
+        }
+    }
+
+    SECTION("Sequential mode loads each document once across threads") {
+        constexpr int kThreads = 4;
+        NodeSource ns{"i: " + fromFile(file, ", field: i"), ""};
+        std::vector<std::vector<int64_t>> seen(kThreads);
+        std::vector<std::thread> threads;
+        // Keep a generator around so the dataset, and its position, outlive every thread's.
+        DefaultRandom rng;
+        DocumentGenerator keepAlive{ns.root(), GeneratorArgs{rng, 1}};
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&, t]() {
+                DefaultRandom rng{uint64_t(t)};
+                DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, ActorId(t)}};
+                for (int j = 0; j < kDocuments / kThreads; ++j) {
+                    seen[t].push_back(docGen().view()["i"].get_int64().value);
+                }
+            });
+        }
+        for (auto&& thread : threads) {
+            thread.join();
+        }
+        std::vector<int64_t> all;
+        for (auto&& values : seen) {
+            REQUIRE(std::is_sorted(values.begin(), values.end()));
+            all.insert(all.end(), values.begin(), values.end());
+        }
+        REQUIRE(sorted(all) == allIndexes());
+    }
+
+    SECTION("Sequential mode shares its position between worker processes") {
+        v1::WorkerGroup group{2};
+        NodeSource ns{"i: " + fromFile(file, ", field: i"), ""};
+        DefaultRandom rng;
+        DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1, ActorThread{0, 1, &group}}};
+        const pid_t child = fork();
+        if (child == 0) {
+            group.joinAs(1);
+            for (int j = 0; j < 3; ++j) {
+                docGen();
+            }
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(child, &status, 0);
+        REQUIRE(WIFEXITED(status));
+        REQUIRE(docGen().view()["i"].get_int64().value == 3);
+    }
+
+    SECTION("Sequential mode starts over at the end of the file") {
+        auto values = draw(fromFile(file, ", mode: sequential"), kDocuments + 3);
+        REQUIRE(values[kDocuments - 1] == kDocuments - 1);
+        REQUIRE(values[kDocuments] == 0);
+        REQUIRE(values[kDocuments + 2] == 2);
+    }
+
+    SECTION("Shuffled mode visits every document once per pass") {
+        auto values = draw(fromFile(file, ", mode: shuffled"), 2 * kDocuments);
+        std::vector<int64_t> first(values.begin(), values.begin() + kDocuments);
+        std::vector<int64_t> second(values.begin() + kDocuments, values.end());
+        REQUIRE(first != allIndexes());
+        REQUIRE(first != second);
+        REQUIRE(sorted(first) == allIndexes());
+        REQUIRE(sorted(second) == allIndexes());
+        REQUIRE(draw(fromFile(file, ", mode: shuffled"), 2 * kDocuments) == values);
+    }
+
+    SECTION("Random mode picks from the whole file") {
+        auto values = draw(fromFile(file, ", mode: random"), 20 * kDocuments);
+        std::set<int64_t> distinct(values.begin(), values.end());
+        REQUIRE(distinct.size() == kDocuments);
+        REQUIRE(*distinct.begin() == 0);
+        REQUIRE(*distinct.rbegin() == kDocuments - 1);
+    }
+
+    SECTION("Fields") {
+        NodeSource ns{"city: " + fromFile(file, ", field: address.city") +
+                          "\nmissing: " + fromFile(file, ", field: address.zip") +
+                          "\nwhole: " + fromFile(file, ", field: address"),
+                      ""};
+        DefaultRandom rng;
+        DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1}};
+        auto doc = docGen();
+        REQUIRE(doc.view()["city"].get_utf8().value == "c0");
+        REQUIRE(doc.view()["missing"].type() == bsoncxx::type::k_null);
+        REQUIRE(doc.view()["whole"].type() == bsoncxx::type::k_document);
+        // Each ^FromFile reads its own documents, so the three above had one each.
+        REQUIRE(docGen().view()["city"].get_utf8().value == "c3");
+    }
+
+    SECTION("Ids come before the file's fields") {
+        NodeSource ns{fromFile(file, ""), ""};
+        DefaultRandom rng;
+        DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1}};
+        DocumentGenerator::Arena arena;
+        auto& views = docGen.generateBatch(3, arena, 7);
+        REQUIRE(views.size() == 3);
+        REQUIRE(views[2]["_id"].type() == bsoncxx::type::k_int32);
+        REQUIRE(views[2]["i"].get_int64().value == 2);
+    }
+
+    SECTION("Top-level fields must be documents") {
+        NodeSource ns{fromFile(file, ", field: name"), ""};
+        DefaultRandom rng;
+        DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1}};
+        REQUIRE_THROWS_AS(docGen(), InvalidValueGeneratorSyntax);
+    }
+
+    SECTION("Rejects bad modes") {
+        REQUIRE_THROWS_AS(draw(fromFile(file, ", mode: backwards"), 1),
+                          InvalidValueGeneratorSyntax);
+    }
+}
+
+TEST_CASE("^FromFile with JSON lines") {
+    TempFile file{".jsonl"};
+    file.write(R"({"name": "a"}
+
+{"name": "b"}
+)");
+    NodeSource ns{"name: " + fromFile(file, ", field: name"), ""};
+    DefaultRandom rng;
+    DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1}};
+    REQUIRE(docGen().view()["name"].get_utf8().value == "a");
+    REQUIRE(docGen().view()["name"].get_utf8().value == "b");
+    REQUIRE(docGen().view()["name"].get_utf8().value == "a");
+}
+
+TEST_CASE("^FromFile rejects bad files") {
+    SECTION("Missing") {
+        REQUIRE_THROWS_AS(draw("{^FromFile: {path: /does/not/exist.bson}}", 1),
+                          InvalidValueGeneratorSyntax);
+    }
+
+    SECTION("Not a regular file") {
+        const auto dir = boost::filesystem::temp_directory_path().string();
+        REQUIRE_THROWS_WITH(draw("{^FromFile: {path: '" + dir + "'}}", 1),
+                            Catch::Contains("Can't map '" + dir + "'"));
+    }
+
+    SECTION("Empty") {
+        TempFile file{".bson"};
+        file.write("");
+        REQUIRE_THROWS_AS(draw(fromFile(file, ""), 1), InvalidValueGeneratorSyntax);
+    }
+
+    SECTION("Truncated") {
+        TempFile file{".bson"};
+        auto bytes = dataset();
+        file.write(bytes.substr(0, bytes.size() - 3));
+        REQUIRE_THROWS_AS(draw(fromFile(file, ""), 1), InvalidValueGeneratorSyntax);
+    }
+
+    SECTION("Invalid JSON") {
+        TempFile file{".json"};
+        file.write("{\"a\": 1}\nnot json\n");
+        REQUIRE_THROWS_AS(draw(fromFile(file, ""), 1), InvalidValueGeneratorSyntax);
+    }
+}
+
+}  // namespace
+}  // namespace genny
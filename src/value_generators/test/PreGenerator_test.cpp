@@ -0,0 +1,159 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gennylib/Node.hpp>
+#include <gennylib/v1/ActorScheduler.hpp>
+
+#include <testlib/helpers.hpp>
+
+#include <value_generators/DefaultRandom.hpp>
+#include <value_generators/DocumentGenerator.hpp>
+#include <value_generators/PreGenerator.hpp>
+
+namespace genny {
+namespace {
+
+const char* kTemplate = R"(
+    a: {^RandomInt: {min: 0, max: 1000000}}
+    b: {^FastRandomString: {length: {^RandomInt: {min: 1, max: 50}}}}
+    c: {^Inc: {start: 10}}
+)";
+
+using Bytes = std::vector<uint8_t>;
+
+Bytes bytesOf(bsoncxx::document::view view) {
+    return Bytes(view.data(), view.data() + view.length());
+}
+
+/**
+ * What the stream should produce: the same template and seed evaluated inline.
+ */
+std::vector<Bytes> inlineDocuments(const Node& node, uint64_t seed, ActorId id, int n) {
+    DefaultRandom rng{seed};
+    DocumentGenerator docGen{node, GeneratorArgs{rng, id}};
+    std::vector<Bytes> out;
+    for (int i = 0; i < n; ++i) {
+        out.push_back(bytesOf(docGen().view()));
+    }
+    return out;
+}
+
+std::vector<Bytes> consume(PreGenerator::Stream& stream, int n) {
+    std::vector<Bytes> out;
+    for (int i = 0; i < n; ++i) {
+        out.push_back(bytesOf(stream.next()));
+    }
+    return out;
+}
+
+TEST_CASE("PreGenerator") {
+    NodeSource ns{kTemplate, ""};
+    constexpr int kDocuments = 2000;
+
+    SECTION("Streams match inline generation") {
+        for (size_t threads : {1, 3}) {
+            for (size_t depth : {1, 7, 1024}) {
+                INFO("threads=" << threads << " depth=" << depth);
+                PreGenerator preGenerator{threads, depth};
+                std::vector<std::shared_ptr<PreGenerator::Stream>> streams;
+                for (ActorId id = 1; id <= 4; ++id) {
+                    streams.push_back(preGenerator.stream(ns.root(), DefaultRandom{id * 7}, id));
+                }
+                // Interleave consumers so some streams fill up while others are drained.
+                for (ActorId id = 4; id >= 1; --id) {
+                    REQUIRE(consume(*streams[id - 1], kDocuments) ==
+                            inlineDocuments(ns.root(), id * 7, id, kDocuments));
+                }
+            }
+        }
+    }
+
+    SECTION("Streams seeded by counter match inline generation") {
+        const DocumentGenerator::CounterSeed counterSeed{11, 1, v1::EngineType::kPhilox4x64};
+        PreGenerator preGenerator{2, 64};
+        auto stream = preGenerator.stream(ns.root(), 3, counterSeed);
+        DocumentGenerator docGen{ns.root(), 3, counterSeed};
+        for (int i = 0; i < kDocuments; ++i) {
+            REQUIRE(bytesOf(stream->next()) == bytesOf(docGen().view()));
+        }
+    }
+
+    SECTION("Consumers in an ActorScheduler wait as fibers") {
+        // Depth 1, so the consumers keep running out of documents.
+        PreGenerator preGenerator{2, 1};
+        std::vector<std::shared_ptr<PreGenerator::Stream>> streams;
+        std::vector<std::vector<Bytes>> consumed(4);
+        std::vector<v1::ActorScheduler::Task> tasks;
+        for (ActorId id = 1; id <= 4; ++id) {
+            streams.push_back(preGenerator.stream(ns.root(), DefaultRandom{id * 7}, id));
+            tasks.push_back([&, id]() { consumed[id - 1] = consume(*streams[id - 1], 500); });
+        }
+        v1::ActorScheduler{1}.run(std::move(tasks));
+        for (ActorId id = 1; id <= 4; ++id) {
+            REQUIRE(consumed[id - 1] == inlineDocuments(ns.root(), id * 7, id, 500));
+        }
+    }
+
+    SECTION("Views stay valid until the next call") {
+        PreGenerator preGenerator{1, 2};
+        auto stream = preGenerator.stream(ns.root(), DefaultRandom{5}, 1);
+        auto expected = inlineDocuments(ns.root(), 5, 1, 100);
+        for (auto&& bytes : expected) {
+            auto view = stream->next();
+            // Give the helper time to fill every slot it's allowed to.
+            std::this_thread::sleep_for(std::chrono::microseconds{200});
+            REQUIRE(bytesOf(view) == bytes);
+        }
+    }
+
+    SECTION("Streams generate nothing before their first next()") {
+        NodeSource counted{"n: {^Inc: {scope: workload, block: 1, name: preGeneratorLazy}}", ""};
+        PreGenerator preGenerator{1, 16};
+        auto stream = preGenerator.stream(counted.root(), DefaultRandom{}, 1);
+        // Long enough for a running helper to fill the stream.
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        DefaultRandom rng;
+        DocumentGenerator other{counted.root(), GeneratorArgs{rng, 2}};
+        REQUIRE(other().view()["n"].get_int64().value == 0);
+        REQUIRE(stream->next()["n"].get_int64().value == 1);
+    }
+
+    SECTION("Errors reach the consumer") {
+        NodeSource failing{"a: {^RandomInt: {distribution: latest, inc: missing}}", ""};
+        PreGenerator preGenerator{1, 16};
+        auto stream = preGenerator.stream(failing.root(), DefaultRandom{}, 1);
+        REQUIRE_THROWS_AS(stream->next(), InvalidValueGeneratorSyntax);
+    }
+
+    SECTION("Bad templates throw when the stream is created") {
+        NodeSource bad{"a: {^NotAGenerator: {}}", ""};
+        PreGenerator preGenerator{1, 16};
+        REQUIRE_THROWS_AS(preGenerator.stream(bad.root(), DefaultRandom{}, 1),
+                          InvalidValueGeneratorSyntax);
+    }
+
+    SECTION("Rejects bad sizes") {
+        REQUIRE_THROWS_AS(PreGenerator(0, 16), std::invalid_argument);
+        REQUIRE_THROWS_AS(PreGenerator(1, 0), std::invalid_argument);
+    }
+}
+
+}  // namespace
+}  // namespace genny
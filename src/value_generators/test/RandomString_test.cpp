@@ -0,0 +1,118 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <map>
+#include <string>
+
+#include <testlib/helpers.hpp>
+
+#include <value_generators/v1/RandomString.hpp>
+
+namespace genny::v1 {
+namespace {
+
+using Isa = RandomStringKernel::Isa;
+
+std::string alphabetOfSize(size_t n) {
+    std::string out;
+    for (size_t i = 0; i < n; ++i) {
+        out.push_back(static_cast<char>(i % 256));
+    }
+    return out;
+}
+
+/**
+ * Check `samples` against a uniform choice of positions in `alphabet`, which may repeat
+ * characters, with Pearson's chi-squared test.
+ */
+bool looksUniform(const std::string& alphabet, const std::string& samples) {
+    std::map<char, double> weights;
+    for (char c : alphabet) {
+        weights[c] += 1.0 / alphabet.size();
+    }
+    std::map<char, size_t> counts;
+    for (char c : samples) {
+        ++counts[c];
+    }
+    double stat = 0;
+    for (auto&& [c, weight] : weights) {
+        const double expected = weight * samples.size();
+        const double diff = counts[c] - expected;
+        stat += diff * diff / expected;
+    }
+    // The statistic has mean dof and variance 2*dof. Allow a very generous margin so this
+    // doesn't flake but still catches the bias of e.g. a plain modulo.
+    const double dof = weights.size() - 1;
+    return stat < dof + 10 * std::sqrt(2 * dof);
+}
+
+TEST_CASE("RandomStringKernel") {
+    SECTION("Fills exactly the requested length") {
+        RandomStringKernel kernel{"ab"};
+        for (size_t length : {0, 1, 7, 8, 9, 31, 32, 33, 100}) {
+            std::string str(length + 1, '-');
+            kernel.fill(str.data(), length, 12345);
+            INFO("length=" << length);
+            REQUIRE(str.find_first_not_of("ab") == length);
+            REQUIRE(str.back() == '-');
+        }
+    }
+
+    SECTION("Every instruction set gives the same characters") {
+        for (size_t n : {1, 2, 10, 16, 62, 64, 100}) {
+            const auto alphabet = alphabetOfSize(n);
+            RandomStringKernel scalar{alphabet, Isa::kScalar};
+            for (auto isa : {Isa::kSse4, Isa::kAvx2}) {
+                if (!RandomStringKernel::supported(isa)) {
+                    continue;
+                }
+                RandomStringKernel vector{alphabet, isa};
+                for (size_t length : {0, 5, 16, 31, 32, 33, 64, 1000, 1027}) {
+                    std::string expected(length, '\0');
+                    std::string actual(length, '\0');
+                    scalar.fill(expected.data(), length, length * 7919);
+                    vector.fill(actual.data(), length, length * 7919);
+                    INFO("n=" << n << " length=" << length);
+                    REQUIRE(expected == actual);
+                }
+            }
+        }
+    }
+
+    SECTION("Characters are uniform") {
+        // Sizes hitting each of the masked, rejection and wide mappings. The old
+        // ^FastRandomString mapping failed this for every size but 1.
+        for (size_t n : {3, 10, 64, 65, 200, 300}) {
+            const auto alphabet = alphabetOfSize(n);
+            RandomStringKernel kernel{alphabet};
+            std::string samples(n * 2000, '\0');
+            kernel.fill(samples.data(), samples.size(), n);
+            INFO("n=" << n);
+            REQUIRE(looksUniform(alphabet, samples));
+        }
+    }
+
+    SECTION("Different seeds give different strings") {
+        RandomStringKernel kernel{alphabetOfSize(64)};
+        std::string a(64, '\0');
+        std::string b(64, '\0');
+        kernel.fill(a.data(), a.size(), 1);
+        kernel.fill(b.data(), b.size(), 2);
+        REQUIRE(a != b);
+    }
+}
+
+}  // namespace
+}  // namespace genny::v1
@@ -0,0 +1,208 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <gennylib/Node.hpp>
+
+#include <testlib/helpers.hpp>
+
+#include <value_generators/DefaultRandom.hpp>
+#include <value_generators/DocumentGenerator.hpp>
+#include <value_generators/v1/SkewedDistributions.hpp>
+
+namespace genny {
+namespace {
+
+double exactZeta(uint64_t n, double theta) {
+    double sum = 0;
+    for (uint64_t i = 1; i <= n; ++i) {
+        sum += std::pow(double(i), -theta);
+    }
+    return sum;
+}
+
+TEST_CASE("zeta") {
+    for (double theta : {0.5, 0.8, 0.99}) {
+        for (uint64_t n : {1, 2, 100, 10000, 10001, 123457, 2000000}) {
+            INFO("theta=" << theta << " n=" << n);
+            REQUIRE(v1::zeta(n, theta) == Approx(exactZeta(n, theta)).epsilon(1e-12));
+        }
+    }
+}
+
+TEST_CASE("ZipfianDistribution") {
+    SECTION("Rejects bad parameters") {
+        REQUIRE_THROWS_AS(v1::ZipfianDistribution(0, 0.99), std::invalid_argument);
+        REQUIRE_THROWS_AS(v1::ZipfianDistribution(10, 1), std::invalid_argument);
+        REQUIRE_THROWS_AS(v1::ZipfianDistribution(10, 0), std::invalid_argument);
+    }
+
+    SECTION("Ranks are in range") {
+        v1::ZipfianDistribution one{1, 0.99};
+        v1::ZipfianDistribution billions{5'000'000'000, 0.99};
+        for (double u : {0.0, 0.3, 0.5, 0.999, 0.9999999999}) {
+            REQUIRE(one.sample(u) == 0);
+            REQUIRE(billions.sample(u) < 5'000'000'000);
+        }
+    }
+
+    SECTION("Low ranks follow the zipfian probabilities") {
+        constexpr uint64_t kItems = 1000;
+        constexpr int kSamples = 1'000'000;
+        constexpr double kTheta = 0.99;
+        v1::ZipfianDistribution distribution{kItems, kTheta};
+        DefaultRandom rng;
+        std::vector<int> counts(kItems);
+        for (int i = 0; i < kSamples; ++i) {
+            ++counts[distribution(rng)];
+        }
+        // The first two ranks are exact. Later ones come from Gray's approximation, which is
+        // only close.
+        const auto zetan = exactZeta(kItems, kTheta);
+        REQUIRE(counts[0] / double(kSamples) == Approx(1 / zetan).epsilon(0.02));
+        REQUIRE(counts[1] / double(kSamples) == Approx(std::pow(2, -kTheta) / zetan).epsilon(0.02));
+        REQUIRE(counts[0] > counts[10]);
+        REQUIRE(counts[10] > counts[500]);
+    }
+
+    SECTION("Growing matches constructing") {
+        v1::ZipfianDistribution grown{1, 0.9};
+        for (uint64_t items : {2, 3, 50, 20000, 20001, 3'000'000}) {
+            grown.grow(items);
+            v1::ZipfianDistribution fresh{items, 0.9};
+            REQUIRE(grown.items() == items);
+            for (double u : {0.1, 0.5, 0.9}) {
+                INFO("items=" << items << " u=" << u);
+                REQUIRE(grown.sample(u) == fresh.sample(u));
+            }
+        }
+    }
+}
+
+TEST_CASE("fnv1a64") {
+    // FNV-1a of eight zero bytes.
+    REQUIRE(v1::fnv1a64(0) == 0xa8c7f832281a39c5ull);
+    REQUIRE(v1::fnv1a64(1) != v1::fnv1a64(2));
+}
+
+int64_t valueOfA(DocumentGenerator& docGen) {
+    return docGen().view()["a"].get_int64().value;
+}
+
+std::vector<int64_t> generate(const std::string& yaml, int n) {
+    NodeSource ns{yaml, ""};
+    DefaultRandom rng;
+    DocumentGenerator docGen{ns.root(), GeneratorArgs{rng, 1}};
+    std::vector<int64_t> out;
+    for (int i = 0; i < n; ++i) {
+        out.push_back(valueOfA(docGen));
+    }
+    return out;
+}
+
+TEST_CASE("Skewed ^RandomInt distributions") {
+    SECTION("zipfian favors min") {
+        auto values = generate("a: {^RandomInt: {distribution: zipfian, min: 10, max: 19}}", 1000);
+        int mins = 0;
+        for (auto value : values) {
+            REQUIRE(value >= 10);
+            REQUIRE(value <= 19);
+            mins += value == 10;
+        }
+        REQUIRE(mins > 250);
+    }
+
+    SECTION("scrambled_zipfian stays in range") {
+        auto values = generate(
+            "a: {^RandomInt: {distribution: scrambled_zipfian, min: -5, max: 5, theta: 0.5}}",
+            1000);
+        for (auto value : values) {
+            REQUIRE(value >= -5);
+            REQUIRE(value <= 5);
+        }
+    }
+
+    SECTION("hotspot") {
+        auto values = generate(R"(
+            a: {^RandomInt: {distribution: hotspot, min: 0, max: 99, hotFraction: 0.1,
+                             hotOpFraction: 0.9}}
+        )",
+                               10000);
+        int hot = 0;
+        for (auto value : values) {
+            REQUIRE(value >= 0);
+            REQUIRE(value <= 99);
+            hot += value < 10;
+        }
+        REQUIRE(hot > 8500);
+        REQUIRE(hot < 9500);
+    }
+
+    SECTION("Bad parameters") {
+        REQUIRE_THROWS_AS(generate("a: {^RandomInt: {distribution: zipfian, min: 5, max: 1}}", 1),
+                          InvalidValueGeneratorSyntax);
+        REQUIRE_THROWS_AS(
+            generate("a: {^RandomInt: {distribution: zipfian, min: 1, max: 5, theta: 1.5}}", 1),
+            InvalidValueGeneratorSyntax);
+        REQUIRE_THROWS_AS(generate(R"(
+            a: {^RandomInt: {distribution: hotspot, min: 0, max: 9, hotFraction: 2,
+                             hotOpFraction: 0.5}}
+        )",
+                                   1),
+                          InvalidValueGeneratorSyntax);
+    }
+}
+
+TEST_CASE("latest ^RandomInt distribution") {
+    NodeSource inserts{"a: {^Inc: {start: 100, step: 10, name: keys}}", ""};
+    NodeSource reads{"a: {^RandomInt: {distribution: latest, inc: keys}}", ""};
+    DefaultRandom rng;
+    DocumentGenerator inc{inserts.root(), GeneratorArgs{rng, 1}};
+    DocumentGenerator latest{reads.root(), GeneratorArgs{rng, 1}};
+
+    // ^Inc starts at start + actorId.
+    const int64_t first = 101;
+
+    SECTION("Needs a value first") {
+        REQUIRE_THROWS_AS(latest(), InvalidValueGeneratorSyntax);
+    }
+
+    SECTION("Picks values already generated, mostly recent ones") {
+        int64_t last = 0;
+        int mostRecent = 0;
+        for (int i = 0; i < 1000; ++i) {
+            last = valueOfA(inc);
+            auto value = valueOfA(latest);
+            REQUIRE(value >= first);
+            REQUIRE(value <= last);
+            REQUIRE((value - first) % 10 == 0);
+            mostRecent += value == last;
+        }
+        REQUIRE(last == first + 999 * 10);
+        REQUIRE(mostRecent > 100);
+    }
+
+    SECTION("Other actors have their own history") {
+        DocumentGenerator otherLatest{reads.root(), GeneratorArgs{rng, 2}};
+        valueOfA(inc);
+        REQUIRE(valueOfA(latest) == first);
+        REQUIRE_THROWS_AS(otherLatest(), InvalidValueGeneratorSyntax);
+    }
+}
+
+}  // namespace
+}  // namespace genny
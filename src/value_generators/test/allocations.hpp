@@ -0,0 +1,29 @@
+// Copyright 2019-present MongoDB Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HEADER_B800EB6D_41DD_4D8C_A624_2D910DCF10A4_INCLUDED
+#define HEADER_B800EB6D_41DD_4D8C_A624_2D910DCF10A4_INCLUDED
+
+#include <cstddef>
+
+namespace genny {
+
+// Counts allocations made by this thread while `countAllocations` is set. The counting
+// operator new is in allocations.cpp.
+inline thread_local bool countAllocations = false;
+inline thread_local size_t allocations = 0;
+
+}  // namespace genny
+
+#endif  // HEADER_B800EB6D_41DD_4D8C_A624_2D910DCF10A4_INCLUDED